@@ -6,6 +6,8 @@
 #pragma once
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
+#include "triangular_table.h" // Include the packed triangular table
 #include <vector> // Include the vector library
 #include "series.h" 
 #include <cmath>
@@ -42,10 +44,12 @@ T ford_sidi_algorithm_three<T, K, series_templ>::operator()(const K n, const K o
     const K n1 = n - 1;
     const K m = n + 1;
 
-    std::vector<T> G(m + 1);
-    std::vector<T> FSA(G.size());
-    std::vector<T> FSI(G.size());
-    std::vector<std::vector<T>> FSG(m + 2, std::vector<T>(G.size()));
+    const std::size_t width = m + 1;
+
+    workspace_vector<T> G(width);
+    workspace_vector<T> FSA(width);
+    workspace_vector<T> FSI(width);
+    triangular_table<T> FSG(n + 1, m); // the column j is used only in the rows m - j, ..., m
 
     G[0] = this->series->operator()(n1) * n;
     
@@ -60,12 +64,12 @@ T ford_sidi_algorithm_three<T, K, series_templ>::operator()(const K n, const K o
     if (G[0] != 0) {
         FSA[n1] /= G[0];
         FSI[n1] /= G[0];
-        for (K i = 1; i <= m; ++i)
-            FSG[i][n1] = G[i] / G[0];
+        for (K i = 2; i <= m; ++i)
+            FSG(i, n1) = G[i] / G[0];
     } 
     else
-        for (K i = 1; i <= m; ++i)
-            FSG[i][n1] = G[i];
+        for (K i = 2; i <= m; ++i)
+            FSG(i, n1) = G[i];
 
     //TODO спросить у Парфенова, ибо жертвуем читаемостью кода, ради его небольшого ускорения
     K MM, MM1, k2;
@@ -76,15 +80,19 @@ T ford_sidi_algorithm_three<T, K, series_templ>::operator()(const K n, const K o
         MM = n1 - k;
         MM1 = MM + 1;
         k2 = k + 2;
-        D = FSG[k2][MM1] - FSG[k2][MM];
+        D = FSG(k2, MM1) - FSG(k2, MM);
+
+        SHANKS_COUNT_CELLS(m - k); // the column MM of FSG from the row k + 3, FSA[MM] and FSI[MM]
+        SHANKS_COUNT_DIVISION(D);
 
         for (K i = k + 3; i <= m; ++i)
-            FSG[i][MM] = (FSG[i][MM1] - FSG[i][MM]) / D;
+            FSG(i, MM) = (FSG(i, MM1) - FSG(i, MM)) / D;
 
         FSA[MM] = (FSA[MM1] - FSA[MM]) / D;
         FSI[MM] = (FSI[MM1] - FSI[MM]) / D;
     }
 
+    SHANKS_COUNT_DIVISION(FSI[0]);
     const T res = FSA[0] / FSI[0];
 
     if (!std::isfinite(res))
@@ -44,6 +44,9 @@ public:
 
 		T delta_S_n = this->series->S_n(m + 1) - this->series->S_n(m);
 
+		SHANKS_COUNT_CELLS(1);
+		SHANKS_COUNT_DIVISION(delta_squared_S_n);
+
 		const T T_n = fma(-delta_S_n, delta_S_n / delta_squared_S_n, this->series->S_n(m));
 
 		if (!isfinite(T_n))
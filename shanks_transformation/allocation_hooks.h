@@ -0,0 +1,137 @@
+/**
+ * @file allocation_hooks.h
+ * @brief This file contains the replacements of the global operator new and operator delete for allocation_profiler.h
+ * The replacements are defined only with SHANKS_ALLOCATION_PROFILING. They are not inline, so the file must be included
+ * by exactly one translation unit of a program, the one with main. Every block is prefixed by its size, so a deallocation
+ * is counted with the same amount of bytes as its allocation even when the unsized operator delete is called.
+ */
+
+#pragma once
+
+#include "allocation_profiler.h" // Include the counters
+
+#ifdef SHANKS_ALLOCATION_PROFILING
+
+#include <cstddef> // Include the cstddef library for std::size_t and std::max_align_t
+#include <cstdlib> // Include the cstdlib library for std::malloc, std::aligned_alloc and std::free
+#include <new>     // Include the new library for std::bad_alloc, std::align_val_t and std::nothrow_t
+#if defined(_MSC_VER)
+#include <malloc.h> // Include the malloc library for _aligned_malloc and _aligned_free
+#endif
+
+/**
+ * @brief Allocates a counted block
+ * The size of the block and the offset of the user memory are kept in the two words before the user memory
+ * @param size The requested bytes
+ * @param alignment The alignment of the user memory
+ * @return The user memory or nullptr if the allocation failed
+ */
+inline void* profiled_allocate(std::size_t size, std::size_t alignment) noexcept
+{
+	if (size == 0)
+		size = 1;
+	if (alignment < alignof(std::max_align_t))
+		alignment = alignof(std::max_align_t);
+
+	// the header is a multiple of the alignment, so the user memory keeps it
+	const std::size_t header = (2 * sizeof(std::size_t) + alignment - 1) / alignment * alignment;
+	if (size > static_cast<std::size_t>(-1) - header - alignment)
+		return nullptr;
+
+#if defined(_MSC_VER)
+	void* const block = _aligned_malloc(header + size, alignment);
+#else
+	void* const block = alignment == alignof(std::max_align_t) ? std::malloc(header + size)
+		: std::aligned_alloc(alignment, (header + size + alignment - 1) / alignment * alignment);
+#endif
+	if (block == nullptr)
+		return nullptr;
+
+	std::size_t* const memory = reinterpret_cast<std::size_t*>(static_cast<char*>(block) + header);
+	memory[-1] = size;
+	memory[-2] = header;
+	record_allocation(size);
+	return memory;
+}
+
+/**
+ * @brief Frees a block of profiled_allocate
+ * @param memory The user memory, may be nullptr
+ */
+inline void profiled_free(void* const memory) noexcept
+{
+	if (memory == nullptr)
+		return;
+
+	const std::size_t* const words = static_cast<const std::size_t*>(memory);
+	record_deallocation(words[-1]);
+	void* const block = static_cast<char*>(memory) - words[-2];
+#if defined(_MSC_VER)
+	_aligned_free(block);
+#else
+	std::free(block);
+#endif
+}
+
+/**
+ * @brief Allocates a counted block or calls the new handler until it succeeds
+ * @param size The requested bytes
+ * @param alignment The alignment of the user memory
+ * @return The user memory
+ */
+inline void* profiled_new(const std::size_t size, const std::size_t alignment)
+{
+	for (;;) {
+		if (void* const memory = profiled_allocate(size, alignment))
+			return memory;
+
+		const std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void* operator new(std::size_t size) { return profiled_new(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return profiled_new(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return profiled_new(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return profiled_new(size, static_cast<std::size_t>(alignment)); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return profiled_new(size, alignof(std::max_align_t)); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return profiled_new(size, alignof(std::max_align_t)); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	try { return profiled_new(size, static_cast<std::size_t>(alignment)); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	try { return profiled_new(size, static_cast<std::size_t>(alignment)); }
+	catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept { profiled_free(memory); }
+void operator delete[](void* memory) noexcept { profiled_free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { profiled_free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { profiled_free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { profiled_free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { profiled_free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { profiled_free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { profiled_free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { profiled_free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { profiled_free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { profiled_free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { profiled_free(memory); }
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file allocation_profiler.h
+ * @brief This file contains the opt-in profiling of the heap allocations made by the transformations
+ * When SHANKS_ALLOCATION_PROFILING is defined, the global operator new and operator delete of allocation_hooks.h
+ * count the allocations, the allocated bytes and the bytes in use of the calling thread. The numbers of a
+ * transformation call are taken with allocation_scope. Without SHANKS_ALLOCATION_PROFILING they are all zero.
+ */
+
+#pragma once
+
+#include <algorithm> // Include the algorithm library for std::max
+#include <cstddef>   // Include the cstddef library for std::size_t
+
+/**
+ * @brief Heap allocations made during a scope
+ */
+struct allocation_counters
+{
+	unsigned long long allocations = 0; // calls of operator new
+	unsigned long long bytes = 0;       // bytes requested by them
+	long long peak_bytes = 0;           // the most bytes in use at once above the ones in use at the start
+};
+
+/**
+ * @brief Whether the allocations are counted
+ */
+#ifdef SHANKS_ALLOCATION_PROFILING
+constexpr bool allocation_profiling_enabled = true;
+#else
+constexpr bool allocation_profiling_enabled = false;
+#endif
+
+/**
+ * @brief Running heap counters of a thread, updated by allocation_hooks.h
+ * A block freed by another thread than the one that allocated it lowers the bytes in use of the freeing thread.
+ */
+struct thread_allocation_state
+{
+	unsigned long long allocations;
+	unsigned long long bytes;
+	long long live_bytes;
+	long long peak_bytes;
+};
+
+/**
+ * @brief The heap counters of the calling thread
+ * They are zero-initialized thread_local data without a constructor, so operator new can use them at any time
+ * @return The counters
+ */
+inline thread_allocation_state& thread_allocations()
+{
+	thread_local thread_allocation_state state;
+	return state;
+}
+
+/**
+ * @brief Counts an allocation of the calling thread
+ * @param size The requested bytes
+ */
+inline void record_allocation(const std::size_t size)
+{
+	thread_allocation_state& state = thread_allocations();
+	++state.allocations;
+	state.bytes += size;
+	state.live_bytes += static_cast<long long>(size);
+	state.peak_bytes = std::max(state.peak_bytes, state.live_bytes);
+}
+
+/**
+ * @brief Counts a deallocation of the calling thread
+ * @param size The bytes of the freed block
+ */
+inline void record_deallocation(const std::size_t size)
+{
+	thread_allocations().live_bytes -= static_cast<long long>(size);
+}
+
+/**
+ * @brief Takes the heap allocations of the calling thread made during the lifetime of the scope
+ * The scopes may be nested, the peak of the outer scope includes the peaks of the inner ones.
+ */
+class allocation_scope
+{
+public:
+	allocation_scope() : start(thread_allocations()) { thread_allocations().peak_bytes = start.live_bytes; }
+
+	allocation_scope(const allocation_scope&) = delete;
+	allocation_scope& operator=(const allocation_scope&) = delete;
+
+	~allocation_scope()
+	{
+		thread_allocation_state& state = thread_allocations();
+		state.peak_bytes = std::max(state.peak_bytes, start.peak_bytes);
+	}
+
+	/**
+	* @brief The allocations made since the construction of the scope
+	* @return The counters, all zero without SHANKS_ALLOCATION_PROFILING
+	*/
+	[[nodiscard]] allocation_counters counters() const
+	{
+		const thread_allocation_state& state = thread_allocations();
+		return { state.allocations - start.allocations, state.bytes - start.bytes, state.peak_bytes - start.live_bytes };
+	}
+
+private:
+	const thread_allocation_state start;
+};
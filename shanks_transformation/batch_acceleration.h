@@ -0,0 +1,193 @@
+/**
+ * @file batch_acceleration.h
+ * @brief This file contains the transformations of the batch series, which accelerate one series for many values of x
+ * The lanes are processed in blocks of block_lanes. The table of a block is stored lane by lane like the tables of
+ * batch_series, so a level of the table for all lanes of the block is one row of the row kernels with the stride of
+ * the block width, and the same (n, order) table is built for every lane at once. The result of every lane is the same
+ * as the one of the single transformation applied to the series with that x.
+ */
+
+#pragma once
+#define DEF_UNDEFINED_SUM 0
+
+#include "batch_series.h" // Include the batch series
+#include "row_kernels.h"  // Include the vectorized row updates
+#include "workspace.h"    // Include the per-thread workspace
+#include <algorithm>      // Include the algorithm library for std::min
+#include <cmath>          // Include the cmath library for std::isfinite
+#include <limits>         // Include the limits library for std::numeric_limits
+#include <stdexcept>      // Include the stdexcept library for std::domain_error
+#include <utility>        // Include the utility library for std::swap
+#include <vector>         // Include the vector library
+
+/**
+ * @brief Abstract class for the transformations of the batch series
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class batch_acceleration
+{
+public:
+	/**
+	* @brief Amount of lanes in a block, so the table of a block stays in the cache
+	*/
+	static constexpr std::size_t block_lanes = 256;
+
+	/**
+	* @brief Parameterized constructor to initialize the transformation with the batch series
+	* @param series The batch series, it must outlive the transformation
+	*/
+	explicit batch_acceleration(const batch_series<T, K>* series) : series(series) {}
+
+	virtual ~batch_acceleration() = default;
+
+	/**
+	* @brief Transforms the partial sum of every lane
+	* @param n The number of terms in the partial sum
+	* @param order The order of transformation
+	* @return The transformed partial sum of every lane, NaN for the lanes where it is not finite
+	*/
+	std::vector<T> operator()(const K n, const K order) const;
+
+protected:
+	/**
+	* @brief Transforms the partial sums of the lanes first, ..., first + count - 1
+	* @param n The number of terms in the partial sum
+	* @param order The order of transformation
+	* @param first The first lane of the block
+	* @param count The amount of lanes in the block
+	* @param out The transformed partial sums of the block
+	*/
+	virtual void transform_block(const K n, const K order, const std::size_t first, const std::size_t count, T* out) const = 0;
+
+	/**
+	* @brief The batch series whose convergence we accelerate
+	*/
+	const batch_series<T, K>* series;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+std::vector<T> batch_acceleration<T, K>::operator()(const K n, const K order) const
+{
+	const std::size_t L = series->lanes();
+	std::vector<T> result(L);
+
+	for (std::size_t first = 0; first < L; first += block_lanes)
+		transform_block(n, order, first, std::min(block_lanes, L - first), result.data() + first);
+
+	for (T& value : result)
+		if (!std::isfinite(value))
+			value = std::numeric_limits<T>::quiet_NaN();
+
+	return result;
+}
+
+/**
+ * @brief Shanks multistep epsilon algorithm for the batch series, the same table as in epsilon_algorithm for every lane
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class batch_epsilon_algorithm : public batch_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the epsilon algorithm for the batch series
+	* @param series The batch series
+	*/
+	explicit batch_epsilon_algorithm(const batch_series<T, K>* series) : batch_acceleration<T, K>(series) {}
+
+protected:
+	void transform_block(const K n, const K order, const std::size_t first, const std::size_t count, T* out) const;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+void batch_epsilon_algorithm<T, K>::transform_block(const K n, const K order, const std::size_t first, const std::size_t count, T* out) const
+{
+	if (order == 0) {
+		workspace_vector<T> S((static_cast<std::size_t>(n) + 1) * count);
+		this->series->partial_sums(n, first, count, S.data());
+		std::copy(S.data() + static_cast<std::size_t>(n) * count, S.data() + S.size(), out);
+		return;
+	}
+
+	if (n == 0)
+		throw std::domain_error("zero integer in the input");
+
+	const K m = 2 * order;
+	const K n1 = n - 1;
+	const std::size_t width = m + 2; // the columns are kept from the element n1 on, see epsilon_algorithm
+
+	workspace_vector<T> S((static_cast<std::size_t>(n1) + width) * count);
+	this->series->partial_sums(n1 + width - 1, first, count, S.data());
+
+	workspace_vector<T> e0(width * count, 0);
+	workspace_vector<T> e1(width * count, 0); // the column -1 is zero
+
+	if (n1 != 0) // otherwise the column 0 starts with 0
+		std::copy(S.data() + static_cast<std::size_t>(n1) * count, S.data() + S.size(), e0.data());
+	else
+		std::copy(S.data() + count, S.data() + S.size(), e0.data() + count);
+
+	for (std::size_t i = 0; i < m; ++i) {
+		wynn_row(e1.data(), e1.data(), e0.data(), (width - 1 - i) * count, count);
+		std::swap(e0, e1);
+	}
+
+	std::copy(e0.data(), e0.data() + count, out);
+}
+
+/**
+ * @brief Shanks transformation for the batch series, the same table as in shanks_transform for every lane
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class batch_shanks_transform : public batch_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the Shanks transformation for the batch series
+	* @param series The batch series
+	*/
+	explicit batch_shanks_transform(const batch_series<T, K>* series) : batch_acceleration<T, K>(series) {}
+
+protected:
+	void transform_block(const K n, const K order, const std::size_t first, const std::size_t count, T* out) const;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+void batch_shanks_transform<T, K>::transform_block(const K n, const K order, const std::size_t first, const std::size_t count, T* out) const
+{
+	if (order == 0) {
+		workspace_vector<T> S((static_cast<std::size_t>(n) + 1) * count);
+		this->series->partial_sums(n, first, count, S.data());
+		std::copy(S.data() + static_cast<std::size_t>(n) * count, S.data() + S.size(), out);
+		return;
+	}
+
+	if (n < order || n == 0) {
+		std::fill(out, out + count, T(DEF_UNDEFINED_SUM));
+		return;
+	}
+
+	// the first level uses the terms and the partial sums up to n + order, the level j lies on [n - order + j, n + order - j]
+	const std::size_t last = static_cast<std::size_t>(n) + order;
+
+	workspace_vector<T> a((last + 1) * count);
+	workspace_vector<T> S((last + 1) * count);
+	this->series->terms(static_cast<K>(last), first, count, a.data());
+	this->series->partial_sums(static_cast<K>(last), first, count, S.data());
+
+	workspace_vector<T> T_n(last * count, 0);
+	workspace_vector<T> T_n_plus_1(last * count, 0);
+
+	const std::size_t low = static_cast<std::size_t>(n - order + 1) * count;
+	aitken_row(T_n.data() + low, a.data() + low, S.data() + low, (2 * static_cast<std::size_t>(order) - 1) * count, count);
+
+	for (std::size_t j = 2; j <= order; ++j) {
+		const std::size_t from = (static_cast<std::size_t>(n) - order + j) * count;
+		shanks_row(T_n_plus_1.data() + from, T_n.data() + from, (2 * (static_cast<std::size_t>(order) - j) + 1) * count, count);
+		std::swap(T_n, T_n_plus_1);
+	}
+
+	std::copy(T_n.data() + static_cast<std::size_t>(n) * count, T_n.data() + (static_cast<std::size_t>(n) + 1) * count, out);
+}
@@ -0,0 +1,245 @@
+/**
+ * @file batch_series.h
+ * @brief This file contains the batch series, which hold one functional series for many values of x
+ * A batch series stores its arguments as an array of lanes and generates the terms of a block of lanes at once. The tables
+ * are stored lane by lane (structure of arrays): the element i * count + l is the ith term or partial sum of the lane
+ * first + l, so the loops over the lanes run over contiguous memory. The terms of every lane are the same as the ones of
+ * the series from series.h with that x. The tables are given to the batch transformations of batch_acceleration.h.
+ * List of batch series currently avaiable:
+ * 1 - exp_batch_series
+ * 2 - cos_batch_series
+ * 3 - sin_batch_series
+ * 4 - arctg_x_batch_series
+ */
+
+#pragma once
+
+#include <cmath>     // Include the cmath library for std::fma and std::pow
+#include <concepts>  // Include the concepts library for std::floating_point
+#include <cstddef>   // Include the cstddef library for std::size_t
+#include <stdexcept> // Include the stdexcept library for std::domain_error
+#include <string>    // Include the string library for std::to_string
+#include <utility>   // Include the utility library for std::move
+#include <vector>    // Include the vector library
+
+/**
+ * @brief Abstract class for batch series
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class batch_series
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the batch series with the arguments of the lanes
+	* @param x The arguments of the function series, one per lane
+	*/
+	explicit batch_series(std::vector<T> x);
+
+	virtual ~batch_series() = default;
+
+	/**
+	* @brief Computes the terms a_0, ..., a_n of the lanes first, ..., first + count - 1
+	* @param n The number of the last term
+	* @param first The first lane of the block
+	* @param count The amount of lanes in the block
+	* @param out The table of (n + 1) * count elements, the element i * count + l is a_i of the lane first + l
+	*/
+	virtual void terms(K n, std::size_t first, std::size_t count, T* out) const = 0;
+
+	/**
+	* @brief Computes the partial sums S_0, ..., S_n of the lanes first, ..., first + count - 1
+	* They are summed up in the same order as by series_base::S_n, so they are the same as the ones of the single series
+	* @param n The amount of terms in the last partial sum
+	* @param first The first lane of the block
+	* @param count The amount of lanes in the block
+	* @param out The table of (n + 1) * count elements, the element i * count + l is S_i of the lane first + l
+	*/
+	void partial_sums(K n, std::size_t first, std::size_t count, T* out) const;
+
+	/**
+	* @brief Amount of lanes
+	* @return The amount of the arguments
+	*/
+	[[nodiscard]] std::size_t lanes() const;
+
+	/**
+	* @brief x getter
+	* @return The arguments of the lanes
+	*/
+	[[nodiscard]] const std::vector<T>& get_x() const;
+
+protected:
+	/**
+	* @brief function series arguments, one per lane
+	*/
+	const std::vector<T> x;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+batch_series<T, K>::batch_series(std::vector<T> x) : x(std::move(x)) {}
+
+template <std::floating_point T, std::unsigned_integral K>
+void batch_series<T, K>::partial_sums(K n, std::size_t first, std::size_t count, T* out) const
+{
+	terms(n, first, count, out);
+
+	const std::size_t size = (static_cast<std::size_t>(n) + 1) * count;
+
+	for (std::size_t f = 0; f < count; ++f)
+		out[f] = T(0) + out[f]; // S_0 = 0 + a_0 like in series_base::S_n
+
+	for (std::size_t f = count; f < size; ++f)
+		out[f] = out[f - count] + out[f];
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+std::size_t batch_series<T, K>::lanes() const
+{
+	return x.size();
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+const std::vector<T>& batch_series<T, K>::get_x() const
+{
+	return x;
+}
+
+/**
+* @brief Maclaurin series of exp(x) function for many x
+* @tparam T The type of the elements in the series, K The type of enumerating integer
+*/
+template <std::floating_point T, std::unsigned_integral K>
+class exp_batch_series : public batch_series<T, K>
+{
+public:
+	exp_batch_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the batch series with the arguments of the lanes
+	* @param x The arguments of the function series
+	*/
+	explicit exp_batch_series(std::vector<T> x) : batch_series<T, K>(std::move(x)) {}
+
+	/**
+	* @brief Computes the terms of the Maclaurin series of the exponent, see exp_series
+	*/
+	void terms(K n, std::size_t first, std::size_t count, T* out) const {
+		const T* x = this->x.data() + first;
+
+		for (std::size_t l = 0; l < count; ++l)
+			out[l] = T(1);
+
+		for (std::size_t i = 1; i <= n; ++i)
+			for (std::size_t l = 0; l < count; ++l)
+				out[i * count + l] = out[(i - 1) * count + l] * x[l] / i; // (1.2) [Rows.pdf]
+	}
+};
+
+/**
+* @brief Maclaurin series of cosine function for many x
+* @tparam T The type of the elements in the series, K The type of enumerating integer
+*/
+template <std::floating_point T, std::unsigned_integral K>
+class cos_batch_series : public batch_series<T, K>
+{
+public:
+	cos_batch_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the batch series with the arguments of the lanes
+	* @param x The arguments of the function series
+	*/
+	explicit cos_batch_series(std::vector<T> x) : batch_series<T, K>(std::move(x)) {}
+
+	/**
+	* @brief Computes the terms of the Maclaurin series of the cosine, see cos_series
+	*/
+	void terms(K n, std::size_t first, std::size_t count, T* out) const {
+		const T* x = this->x.data() + first;
+
+		for (std::size_t l = 0; l < count; ++l)
+			out[l] = T(1);
+
+		if (n == 0)
+			return;
+
+		for (std::size_t l = 0; l < count; ++l)
+			out[count + l] = T(((-1) * x[l] * x[l]) / 2);
+
+		for (std::size_t i = 2; i <= n; ++i) {
+			const auto d = i * std::fma(4, i, -2);
+			for (std::size_t l = 0; l < count; ++l)
+				out[i * count + l] = out[(i - 1) * count + l] * static_cast<T>(static_cast<T>(-x[l] * x[l]) / d); // (2.2) [Rows.pdf]
+		}
+	}
+};
+
+/**
+* @brief Maclaurin series of sine function for many x
+* @tparam T The type of the elements in the series, K The type of enumerating integer
+*/
+template <std::floating_point T, std::unsigned_integral K>
+class sin_batch_series : public batch_series<T, K>
+{
+public:
+	sin_batch_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the batch series with the arguments of the lanes
+	* @param x The arguments of the function series
+	*/
+	explicit sin_batch_series(std::vector<T> x) : batch_series<T, K>(std::move(x)) {}
+
+	/**
+	* @brief Computes the terms of the Maclaurin series of the sine, see sin_series
+	*/
+	void terms(K n, std::size_t first, std::size_t count, T* out) const {
+		const T* x = this->x.data() + first;
+
+		for (std::size_t l = 0; l < count; ++l)
+			out[l] = x[l];
+
+		for (std::size_t i = 1; i <= n; ++i) {
+			const auto d = i * std::fma(4, i, 2);
+			for (std::size_t l = 0; l < count; ++l)
+				out[i * count + l] = out[(i - 1) * count + l] * static_cast<T>(static_cast<T>(-x[l] * x[l]) / d); // (3.2) [Rows.pdf]
+		}
+	}
+};
+
+/**
+* @brief Maclaurin series of arctan function for many x
+* @tparam T The type of the elements in the series, K The type of enumerating integer
+*/
+template <std::floating_point T, std::unsigned_integral K>
+class arctg_x_batch_series : public batch_series<T, K>
+{
+public:
+	arctg_x_batch_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the batch series with the arguments of the lanes
+	* @param x The arguments of the function series, all of them in [-1, 1]
+	*/
+	explicit arctg_x_batch_series(std::vector<T> x) : batch_series<T, K>(std::move(x)) {
+		for (const T x_l : this->x)
+			if (std::abs(x_l) > 1)
+				throw std::domain_error("the atan(x) series diverge at x = " + std::to_string(x_l) + "; series converge if x only in [-1, 1]");
+	}
+
+	/**
+	* @brief Computes the terms of the Maclaurin series of the arctan, see arctg_x_series
+	*/
+	void terms(K n, std::size_t first, std::size_t count, T* out) const {
+		const T* x = this->x.data() + first;
+
+		for (K i = 0; i <= n; ++i) {
+			const K a = static_cast<K>(std::fma(2, i, 1));
+			for (std::size_t l = 0; l < count; ++l)
+				out[i * count + l] = static_cast<T>((1 - 2 * (i & 1)) * std::pow(x[l], a) / a); // (70.1) [Rows.pdf], (1 - 2 * (n & 1)) = (-1)^{n}
+			if (i == n)
+				break;
+		}
+	}
+};
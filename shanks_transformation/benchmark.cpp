@@ -0,0 +1,567 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmark of the transformations over a grid of series, n and order
+ * Every transformation of transformation_id_t is run on a representative subset of the series of series_id_t for every
+ * (n, order) of the grid. A case is run a few times to warm up the memoized terms and partial sums of the series, then
+ * it is timed with std::chrono::steady_clock for the given amount of repetitions. A repetition calls the transformation
+ * as many times as needed to last at least min_sample_ns, so the times of the short calls are not lost in the resolution
+ * of the clock. The median, the 95th percentile, the minimum and the mean time of one call are printed as CSV or JSON.
+ *
+ * Usage: shanks_benchmark [--n 8,16,32] [--order 1,2,4] [--warmup 2] [--repetitions 15] [--format csv|json]
+ *                         [--output file] [--transform id,...] [--series id,...] [--perf on|off]
+ * The ids are the ones of transformation_id_t and series_id_t. By default all transformations and series are run.
+ * With --perf on, the cycles, instructions, cache misses and branch misses of one call are counted with the hardware
+ * counters of perf_counters.h over a separate run of the repetitions. Where the counters are not available, they are
+ * printed as nan in CSV and null in JSON and only the timings are measured.
+ * Built with SHANKS_INSTRUMENTATION, it also prints the counters of instrumentation.h for the first call of every case.
+ * Built with SHANKS_ALLOCATION_PROFILING, it also prints the heap allocations of allocation_profiler.h made by the first
+ * call of every case and the amount of allocations made by a call once the series is memoized.
+ */
+
+#include "test_framework.h"    // Include the series, the transformations and their ids
+#include "allocation_hooks.h"  // Include the counting operator new and operator delete
+#include "perf_counters.h"     // Include the hardware counters
+
+#include <algorithm> // Include the algorithm library for std::sort
+#include <chrono>    // Include the chrono library for std::chrono::steady_clock
+#include <cmath>     // Include the cmath library for std::ceil
+#include <cstring>   // Include the cstring library for std::strcmp
+#include <fstream>   // Include the fstream library for std::ofstream
+#include <iostream>  // Include the iostream library for I/O functionalities
+#include <limits>    // Include the limits library for the precision of the output
+#include <memory>    // Include the memory library for std::unique_ptr
+#include <set>       // Include the set library
+#include <sstream>   // Include the sstream library for std::istringstream
+#include <stdexcept> // Include the stdexcept library for the exceptions of the transformations
+#include <string>    // Include the string library
+#include <vector>    // Include the vector library
+
+using benchmark_float = double;
+using benchmark_int = unsigned long long;
+
+/**
+ * @brief The minimum duration of a repetition in nanoseconds
+ */
+constexpr double min_sample_ns = 20000;
+
+/**
+ * @brief Series of the benchmark with its argument
+ */
+struct benchmark_series_case
+{
+	series_id_t id;
+	const char* name;
+	benchmark_float x;
+};
+
+/**
+ * @brief The series the transformations are run on: fast and slow, alternating and not, elementary and special functions
+ */
+const benchmark_series_case benchmark_series_cases[] = {
+	{ series_id_t::exp_series_id, "exp", 0.5 },
+	{ series_id_t::cos_series_id, "cos", 0.5 },
+	{ series_id_t::ln1mx_series_id, "ln1mx", 0.5 },
+	{ series_id_t::four_arctan_series_id, "four_arctan", 0.5 },
+	{ series_id_t::erf_series_id, "erf", 0.5 },
+	{ series_id_t::ln2_series_id, "ln2", 1 },
+	{ series_id_t::pi_4_series_id, "pi_4", 1 },
+	{ series_id_t::arctg_x_series_id, "arctg_x", 0.9 },
+	{ series_id_t::Riemann_zeta_func_series_id, "Riemann_zeta", 2 },
+	{ series_id_t::K_x_series_id, "K_x", 0.5 },
+};
+
+/**
+ * @brief Names of the transformations in the output, indexed by transformation_id_t
+ */
+const char* const benchmark_transform_names[] = {
+	"null", "shanks", "epsilon", "levin", "epsilon_two", "levin_sidi_S", "drummond_D", "chang_wynn", "levin_sidi_M",
+	"weniger", "rho_wynn", "theta_brezinski", "epsilon_three", "levin_recursion", "lubkin_W", "richardson", "ford_sidi",
+	"ford_sidi_two", "ford_sidi_three", "epsilon_modified", "theta_modified", "epsilon_aitken_theta"
+};
+
+/**
+ * @brief Creates the series of the benchmark
+ * @param id The id of the series
+ * @param x The argument of the series
+ * @return The series
+ */
+template <std::floating_point T, std::unsigned_integral K>
+std::unique_ptr<series_base<T, K>> make_benchmark_series(const series_id_t id, const T x)
+{
+	switch (id)
+	{
+	case series_id_t::exp_series_id:
+		return std::make_unique<exp_series<T, K>>(x);
+	case series_id_t::cos_series_id:
+		return std::make_unique<cos_series<T, K>>(x);
+	case series_id_t::ln1mx_series_id:
+		return std::make_unique<ln1mx_series<T, K>>(x);
+	case series_id_t::four_arctan_series_id:
+		return std::make_unique<four_arctan_series<T, K>>(x);
+	case series_id_t::erf_series_id:
+		return std::make_unique<erf_series<T, K>>(x);
+	case series_id_t::ln2_series_id:
+		return std::make_unique<ln2_series<T, K>>(x);
+	case series_id_t::pi_4_series_id:
+		return std::make_unique<pi_4_series<T, K>>(x);
+	case series_id_t::arctg_x_series_id:
+		return std::make_unique<arctg_x_series<T, K>>(x);
+	case series_id_t::Riemann_zeta_func_series_id:
+		return std::make_unique<Riemann_zeta_func_series<T, K>>(x);
+	case series_id_t::K_x_series_id:
+		return std::make_unique<K_x_series<T, K>>(x);
+	default:
+		throw std::domain_error("the series is not in the benchmark");
+	}
+}
+
+/**
+ * @brief Creates the transformation of the benchmark with the default parameters of main_testing_function
+ * The Levin-type transformations use the u transform without the recurrence formula, rho-Wynn is the classic one.
+ * @param id The id of the transformation
+ * @param series The series
+ * @param alternating Whether the series is alternating
+ * @return The transformation
+ */
+template <std::floating_point T, std::unsigned_integral K, typename series_templ>
+std::unique_ptr<series_acceleration<T, K, series_templ>> make_benchmark_transform(const transformation_id_t id, const series_templ& series, const bool alternating)
+{
+	switch (id)
+	{
+	case transformation_id_t::shanks_transformation_id:
+		if (alternating)
+			return std::make_unique<shanks_transform_alternating<T, K, series_templ>>(series);
+		return std::make_unique<shanks_transform<T, K, series_templ>>(series);
+	case transformation_id_t::epsilon_algorithm_id:
+		return std::make_unique<epsilon_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::levin_algorithm_id:
+		return std::make_unique<levin_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::epsilon_algorithm_2_id:
+		return std::make_unique<epsilon_algorithm_two<T, K, series_templ>>(series);
+	case transformation_id_t::S_algorithm:
+		return std::make_unique<levi_sidi_algorithm<T, K, series_templ>>(series, new u_transform<T, K>{}, false, T(1));
+	case transformation_id_t::D_algorithm:
+		return std::make_unique<drummonds_algorithm<T, K, series_templ>>(series, new u_transform<T, K>{}, false);
+	case transformation_id_t::chang_epsilon_algorithm:
+		return std::make_unique<chang_whynn_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::M_algorithm:
+		return std::make_unique<M_levin_sidi_algorithm<T, K, series_templ>>(series, new u_transform<T, K>{}, T(10));
+	case transformation_id_t::weniger_transformation:
+		return std::make_unique<weniger_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::rho_wynn_transformation_id:
+		return std::make_unique<rho_Wynn_algorithm<T, K, series_templ>>(series, new rho_transform<T, K>{});
+	case transformation_id_t::brezinski_theta_transformation_id:
+		return std::make_unique<theta_brezinski_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::epsilon_algorithm_3_id:
+		return std::make_unique<epsilon_algorithm_three<T, K, series_templ>>(series, T(1e-3));
+	case transformation_id_t::levin_recursion_id:
+		return std::make_unique<levin_recursion_algorithm<T, K, series_templ>>(series, T(-1.5));
+	case transformation_id_t::W_algorithm_id:
+		return std::make_unique<W_lubkin_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::richardson_algorithm_id:
+		return std::make_unique<richardson_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::Ford_Sidi_algorithm_id:
+		return std::make_unique<ford_sidi_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::Ford_Sidi_algorithm_two_id:
+		return std::make_unique<ford_sidi_algorithm_two<T, K, series_templ>>(series);
+	case transformation_id_t::Ford_Sidi_algorithm_three_id:
+		return std::make_unique<ford_sidi_algorithm_three<T, K, series_templ>>(series);
+	case transformation_id_t::epsilon_modified_algorithm_id:
+		return std::make_unique<epsilon_modified_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::theta_modified_algorithm_id:
+		return std::make_unique<theta_modified_algorithm<T, K, series_templ>>(series);
+	case transformation_id_t::epsilon_aitken_theta_algorithm_id:
+		return std::make_unique<epsilon_aitken_theta_algorithm<T, K, series_templ>>(series);
+	default:
+		throw std::domain_error("wrong transformation_id");
+	}
+}
+
+/**
+ * @brief Whether the case is left out of the grid
+ * Order 0 of Ford-Sidi does not terminate and its cost grows as 4^order, so it is run only for orders up to 3.
+ * @param id The id of the transformation
+ * @param order The order of the transformation
+ * @return Whether the case is skipped
+ */
+inline bool benchmark_skips(const transformation_id_t id, const benchmark_int order)
+{
+	if (id == transformation_id_t::Ford_Sidi_algorithm_id)
+		return order == 0 || order > 3;
+	return false;
+}
+
+/**
+ * @brief Timings of one case of the grid
+ */
+struct benchmark_result
+{
+	const char* transform;
+	const char* series;
+	benchmark_int n;
+	benchmark_int order;
+	std::string status; // "ok" or the message of the exception thrown by the transformation
+	benchmark_float value;
+	std::size_t calls_per_repetition;
+	double median_ns;
+	double p95_ns;
+	double min_ns;
+	double mean_ns;
+	transform_counters counters; // of the first call, on a series with nothing memoized
+	allocation_counters allocations; // of the first call
+	unsigned long long warm_allocations; // of a call after the warmup
+	hardware_sample hardware; // per call, with --perf on
+};
+
+/**
+ * @brief Options of the benchmark given in the command line
+ */
+struct benchmark_options
+{
+	std::vector<benchmark_int> n = { 8, 16, 32 };
+	std::vector<benchmark_int> order = { 1, 2, 4 };
+	std::size_t warmup = 2;
+	std::size_t repetitions = 15;
+	bool json = false;
+	std::string output;
+	std::set<unsigned> transforms;
+	std::set<unsigned> series;
+	bool perf = false;
+};
+
+/**
+ * @brief Parses a comma separated list of numbers
+ * @param list The list
+ * @return The numbers
+ */
+inline std::vector<benchmark_int> parse_list(const char* list)
+{
+	std::vector<benchmark_int> values;
+	std::istringstream in(list);
+	std::string value;
+	while (std::getline(in, value, ','))
+		values.push_back(std::stoull(value));
+	return values;
+}
+
+/**
+ * @brief Parses the command line
+ * @param argc The amount of arguments
+ * @param argv The arguments
+ * @return The options
+ */
+inline benchmark_options parse_options(const int argc, char** argv)
+{
+	benchmark_options options;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* option = argv[i];
+		if (i + 1 >= argc)
+			throw std::domain_error(std::string("no value for ") + option);
+		const char* value = argv[++i];
+
+		if (std::strcmp(option, "--n") == 0)
+			options.n = parse_list(value);
+		else if (std::strcmp(option, "--order") == 0)
+			options.order = parse_list(value);
+		else if (std::strcmp(option, "--warmup") == 0)
+			options.warmup = std::stoul(value);
+		else if (std::strcmp(option, "--repetitions") == 0)
+			options.repetitions = std::max<std::size_t>(std::stoul(value), 1);
+		else if (std::strcmp(option, "--format") == 0)
+			options.json = std::strcmp(value, "json") == 0;
+		else if (std::strcmp(option, "--output") == 0)
+			options.output = value;
+		else if (std::strcmp(option, "--transform") == 0)
+			for (const benchmark_int id : parse_list(value))
+				options.transforms.insert(static_cast<unsigned>(id));
+		else if (std::strcmp(option, "--series") == 0)
+			for (const benchmark_int id : parse_list(value))
+				options.series.insert(static_cast<unsigned>(id));
+		else if (std::strcmp(option, "--perf") == 0)
+			options.perf = std::strcmp(value, "on") == 0;
+		else
+			throw std::domain_error(std::string("unknown option ") + option);
+	}
+
+	return options;
+}
+
+/**
+ * @brief Value of the percentile of the sorted samples, the nearest-rank one
+ * @param sorted The sorted samples
+ * @param q The percentile in [0, 1]
+ * @return The value of the percentile
+ */
+inline double percentile(const std::vector<double>& sorted, const double q)
+{
+	const std::size_t rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+	return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+/**
+ * @brief Times one case of the grid
+ * @param test The transformation
+ * @param n The number of terms in the partial sum
+ * @param order The order of the transformation
+ * @param options The options of the benchmark
+ * @param hardware The hardware counters or nullptr if they are not used
+ * @param result The result, its status, value and timings are filled
+ */
+template <typename transform_type>
+void run_case(const transform_type& test, const benchmark_int n, const benchmark_int order, const benchmark_options& options, hardware_counters* hardware, benchmark_result& result)
+{
+	using clock = std::chrono::steady_clock;
+
+	volatile benchmark_float sink = 0;
+	const auto call = [&] { sink = test->operator()(n, order); };
+
+	const counters_scope first_call;
+	const allocation_scope first_allocations;
+
+	try {
+		result.value = test->operator()(n, order);
+		result.counters = first_call.counters();
+		result.allocations = first_allocations.counters();
+		result.status = "ok";
+
+		for (std::size_t i = 0; i < options.warmup; ++i)
+			call();
+
+		if constexpr (allocation_profiling_enabled) {
+			const allocation_scope warm_call;
+			call();
+			result.warm_allocations = warm_call.counters().allocations;
+		}
+
+		// the calls of a repetition last at least min_sample_ns
+		std::size_t calls = 1;
+		for (;;) {
+			const auto start = clock::now();
+			for (std::size_t i = 0; i < calls; ++i)
+				call();
+			const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+			if (elapsed.count() >= min_sample_ns || calls >= (std::size_t(1) << 20))
+				break;
+			calls *= 2;
+		}
+		result.calls_per_repetition = calls;
+
+		std::vector<double> samples(options.repetitions);
+		for (double& sample : samples) {
+			const auto start = clock::now();
+			for (std::size_t i = 0; i < calls; ++i)
+				call();
+			const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+			sample = elapsed.count() / calls;
+		}
+
+		// counted apart from the timed repetitions, so the reads of the counters don't add to the timings
+		if (hardware != nullptr && hardware->available()) {
+			hardware->start();
+			for (std::size_t r = 0; r < options.repetitions; ++r)
+				for (std::size_t i = 0; i < calls; ++i)
+					call();
+			const hardware_sample total = hardware->stop();
+
+			const double total_calls = static_cast<double>(calls * options.repetitions);
+			result.hardware = { total.cycles / total_calls, total.instructions / total_calls, total.cache_misses / total_calls, total.branch_misses / total_calls };
+		}
+
+		std::sort(samples.begin(), samples.end());
+		const std::size_t middle = samples.size() / 2;
+		result.median_ns = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+		result.p95_ns = percentile(samples, 0.95);
+		result.min_ns = samples.front();
+		double sum = 0;
+		for (const double sample : samples)
+			sum += sample;
+		result.mean_ns = sum / samples.size();
+	}
+	catch (std::exception& e) {
+		if (result.status.empty()) { // the first call threw
+			result.counters = first_call.counters();
+			result.allocations = first_allocations.counters();
+		}
+		result.status = e.what();
+	}
+}
+
+/**
+ * @brief Prints the string as a quoted CSV field or JSON string
+ * @param out The stream
+ * @param value The string, it contains no quotes or control characters in JSON
+ * @param json Whether to quote for JSON
+ */
+inline void print_quoted(std::ostream& out, const std::string& value, const bool json)
+{
+	out << '"';
+	for (const char c : value) {
+		if (c == '"')
+			out << (json ? "\\\"" : "\"\"");
+		else if (c == '\\' && json)
+			out << "\\\\";
+		else
+			out << c;
+	}
+	out << '"';
+}
+
+/**
+ * @brief Prints the results as CSV, one line per case
+ * @param out The stream
+ * @param results The results
+ * @param options The options of the benchmark
+ */
+inline void print_csv(std::ostream& out, const std::vector<benchmark_result>& results, const benchmark_options& options)
+{
+	out << "transform,series,n,order,status,value,calls_per_repetition,median_ns,p95_ns,min_ns,mean_ns";
+	if constexpr (instrumentation_enabled)
+		out << ",term_evaluations,partial_sums,table_cells,near_zero_divisions";
+	if constexpr (allocation_profiling_enabled)
+		out << ",allocations,allocated_bytes,peak_bytes,warm_allocations";
+	if (options.perf)
+		out << ",cycles,instructions,cache_misses,branch_misses";
+	out << '\n';
+
+	for (const benchmark_result& r : results) {
+		out << r.transform << ',' << r.series << ',' << r.n << ',' << r.order << ',';
+		print_quoted(out, r.status, false);
+		out << ',' << r.value << ',' << r.calls_per_repetition << ',' << r.median_ns << ',' << r.p95_ns << ',' << r.min_ns << ',' << r.mean_ns;
+		if constexpr (instrumentation_enabled)
+			out << ',' << r.counters.term_evaluations << ',' << r.counters.partial_sums << ',' << r.counters.table_cells << ',' << r.counters.near_zero_divisions;
+		if constexpr (allocation_profiling_enabled)
+			out << ',' << r.allocations.allocations << ',' << r.allocations.bytes << ',' << r.allocations.peak_bytes << ',' << r.warm_allocations;
+		if (options.perf)
+			out << ',' << r.hardware.cycles << ',' << r.hardware.instructions << ',' << r.hardware.cache_misses << ',' << r.hardware.branch_misses;
+		out << '\n';
+	}
+}
+
+/**
+ * @brief Prints a number as JSON, null if it's not finite
+ * @param out The stream
+ * @param value The number
+ */
+inline void print_json_number(std::ostream& out, const double value)
+{
+	if (std::isfinite(value))
+		out << value;
+	else
+		out << "null";
+}
+
+/**
+ * @brief Prints the results and the options as JSON
+ * @param out The stream
+ * @param results The results
+ * @param options The options of the benchmark
+ */
+inline void print_json(std::ostream& out, const std::vector<benchmark_result>& results, const benchmark_options& options)
+{
+	out << "{\n  \"clock\": \"steady_clock\",\n  \"warmup\": " << options.warmup << ",\n  \"repetitions\": " << options.repetitions;
+	out << ",\n  \"simd\": \"" << simd_isa_name(simd_selected_isa()) << "\",\n  \"results\": [";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const benchmark_result& r = results[i];
+		out << (i ? ",\n" : "\n") << "    {\"transform\": \"" << r.transform << "\", \"series\": \"" << r.series << "\", \"n\": " << r.n << ", \"order\": " << r.order;
+		out << ", \"status\": ";
+		print_quoted(out, r.status, true);
+		out << ", \"value\": ";
+		print_json_number(out, r.value);
+		out << ", \"calls_per_repetition\": " << r.calls_per_repetition << ", \"median_ns\": ";
+		print_json_number(out, r.median_ns);
+		out << ", \"p95_ns\": ";
+		print_json_number(out, r.p95_ns);
+		out << ", \"min_ns\": ";
+		print_json_number(out, r.min_ns);
+		out << ", \"mean_ns\": ";
+		print_json_number(out, r.mean_ns);
+		if constexpr (instrumentation_enabled)
+			out << ", \"term_evaluations\": " << r.counters.term_evaluations << ", \"partial_sums\": " << r.counters.partial_sums
+				<< ", \"table_cells\": " << r.counters.table_cells << ", \"near_zero_divisions\": " << r.counters.near_zero_divisions;
+		if constexpr (allocation_profiling_enabled)
+			out << ", \"allocations\": " << r.allocations.allocations << ", \"allocated_bytes\": " << r.allocations.bytes
+				<< ", \"peak_bytes\": " << r.allocations.peak_bytes << ", \"warm_allocations\": " << r.warm_allocations;
+		if (options.perf) {
+			out << ", \"cycles\": ";
+			print_json_number(out, r.hardware.cycles);
+			out << ", \"instructions\": ";
+			print_json_number(out, r.hardware.instructions);
+			out << ", \"cache_misses\": ";
+			print_json_number(out, r.hardware.cache_misses);
+			out << ", \"branch_misses\": ";
+			print_json_number(out, r.hardware.branch_misses);
+		}
+		out << '}';
+	}
+	out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv)
+{
+	using T = benchmark_float;
+	using K = benchmark_int;
+
+	try
+	{
+		const benchmark_options options = parse_options(argc, argv);
+
+		// the same as in main_testing_function
+		const std::set<K> alternating_series = { 2, 3, 7, 11, 15, 18, 19, 20, 21, 24, 26, 28, 30, 31 };
+
+		// opened once for the thread running the cases
+		std::unique_ptr<hardware_counters> hardware;
+		if (options.perf) {
+			hardware = std::make_unique<hardware_counters>();
+			if (!hardware->available())
+				std::cerr << "hardware counters are not available, only the timings are measured" << '\n';
+		}
+
+		std::vector<benchmark_result> results;
+
+		for (const benchmark_series_case& series_case : benchmark_series_cases) {
+			if (!options.series.empty() && !options.series.contains(series_case.id))
+				continue;
+
+			for (unsigned id = transformation_id_t::shanks_transformation_id; id <= transformation_id_t::epsilon_aitken_theta_algorithm_id; ++id) {
+				if (!options.transforms.empty() && !options.transforms.contains(id))
+					continue;
+
+				for (const K n : options.n)
+					for (const K order : options.order) {
+						if (benchmark_skips(static_cast<transformation_id_t>(id), order))
+							continue;
+
+						// a new series for every case, so the memoized partial sums of the previous cases are not reused
+						std::unique_ptr<series_base<T, K>> series = make_benchmark_series<T, K>(series_case.id, series_case.x);
+						if constexpr (instrumentation_enabled) // count the terms the transformation takes
+							series.reset(new counting_series<T, K>(std::move(series)));
+						const auto test = make_benchmark_transform<T, K>(static_cast<transformation_id_t>(id), series.get(), alternating_series.contains(series_case.id));
+
+						benchmark_result result{ benchmark_transform_names[id], series_case.name, n, order, "", std::numeric_limits<T>::quiet_NaN(), 0,
+							std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), {}, {}, 0, {} };
+						run_case(test, n, order, options, hardware.get(), result);
+						results.push_back(std::move(result));
+					}
+			}
+		}
+
+		std::ofstream file;
+		if (!options.output.empty())
+			file.open(options.output);
+		std::ostream& out = options.output.empty() ? std::cout : file;
+		out.precision(std::numeric_limits<T>::max_digits10);
+
+		if (options.json)
+			print_json(out, results, options);
+		else
+			print_csv(out, results, options);
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+
+	return 0;
+}
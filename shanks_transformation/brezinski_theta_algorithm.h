@@ -34,61 +34,71 @@ public:
         if (n == 0 || order == 0)
             return this->series->S_n(n);
 
-        return theta(n, order, this->series->S_n(n), 0);
+        return theta(n, order);
     }
 
 protected:
     /**
-     * @brief Recursive function to compute theta.
-     * Computes the value of theta according to the given parameters.
+     * @brief Function to compute theta with the table.
+     * The table is filled column by column, the column k is computed from the columns k - 1 and k - 2:
+     * υ_(2k+1)^(n) = υ_(2k-1)^(n+1) + 1/(Δυ_2k^(n)),
+     * υ_(2k+2)^(n) = υ_2k^(n+1) + ((Δυ_2k^(n+1))*(Δυ_(2k+1)^(n+1)))/(Δ^2 υ_(2k+1)^(n)),
+     * where υ_0^(n) = S_n and υ_1^(n) = 1/a_(n+1).
+     * υ_order^(n) needs the column k on [n, n + (3 * (order - k) + 1) / 2] and the columns 0 and 1 on [n, n + 3 * order / 2 - 1],
+     * so every element is computed once and only two columns are kept: the column k overwrites the column k - 2 in place.
      * @param n The number of terms in the partial sum.
-     * @param k The order of transformation.
+     * @param order The order of transformation.
      * @return The value of theta.
      */
-    T theta(K n, const K order, T S_n, const K j) const {
-        if (order == 1) {
-            T res = 1 / this->series->operator()(n + j + 1);
-            if (!std::isfinite(res))
-                throw std::overflow_error("division by zero");
+    T theta(const K n, const K order) const {
+        const K width = 3 * order / 2;
 
-            return res;
-        }
+        std::vector<T> theta_prev(width, 0); // column k - 2
+        std::vector<T> theta_cur(width, 0); // column k - 1
 
-        for (K tmp = n + 1; tmp <= n + j; ++tmp)
-            S_n += this->series->operator()(tmp);
+        SHANKS_COUNT_CELLS(2 * width);
+        for (K i = 0; i < width; ++i) {
+            theta_prev[i] = this->series->S_n(n + i);
+            theta_cur[i] = 1 / this->series->operator()(n + i + 1);
+            SHANKS_COUNT_DIVISION(1 / theta_cur[i]); // the term
 
-        n += j;
-
-        if (order == 0)
-            return S_n;
+            if (!std::isfinite(theta_cur[i]))
+                throw std::overflow_error("division by zero");
+        }
 
-        //TODO спросить у Парфенова, ибо жертвуем читаемостью кода, ради его небольшого ускорения
-        const K order1 = order - 1;
-        const K order2 = order - 2;
+        for (K k = 2; k <= order; ++k) {
+            const K last = (3 * (order - k) + 1) / 2;
+            SHANKS_COUNT_CELLS(last + 1);
 
-        const T theta_order1_0 = theta(n, order1, S_n, 0);
-        const T theta_order1_1 = theta(n, order1, S_n, 1);
-        const T theta_order1_2 = theta(n, order1, S_n, 2);
-        const T theta_order2_1 = theta(n, order2, S_n, 1);
+            if (k & 1) { // k is odd
+                for (K i = 0; i <= last; ++i) {
+                    SHANKS_COUNT_DIVISION(theta_cur[i] - theta_cur[i + 1]);
+                    const T delta = T(1) / (theta_cur[i] - theta_cur[i + 1]); // 1/Δυ_2k^(n)
 
-        if (order & 1) { // order is odd
-            const T delta = T(1) / (theta_order1_0 - theta_order1_1); // 1/Δυ_2k^(n)
+                    if (!std::isfinite(delta))
+                        throw std::overflow_error("division by zero");
 
-            if (!std::isfinite(delta))
-                throw std::overflow_error("division by zero");
+                    theta_prev[i] = theta_prev[i + 1] + delta; // υ_(2k+1)^(n)=υ_(2k-1)^(n+1) + 1/(Δυ_2k^(n)
+                }
+            }
+            else { // k is even
+                for (K i = 0; i <= last; ++i) {
+                    SHANKS_COUNT_DIVISION(fma(-2, theta_cur[i + 1], theta_cur[i] + theta_cur[i + 2]));
+                    const T delta2 = T(1) / static_cast<T>(fma(-2, theta_cur[i + 1], theta_cur[i] + theta_cur[i + 2])); // Δ^2 υ_(2k+1)^(n)
 
-            return theta_order2_1 + delta; // υ_(2k+1)^(n)=υ_(2k-1)^(n+1) + 1/(Δυ_2k^(n)
-        }
-        // order is even
+                    if (!std::isfinite(delta2))
+                        throw std::overflow_error("division by zero");
 
-        const T delta2 = T(1) / static_cast<T>(fma(-2, theta_order1_1, theta_order1_0 + theta_order1_2)); // Δ^2 υ_(2k+1)^(n)
+                    const T delta_n = theta_prev[i + 1] - theta_prev[i + 2]; // Δυ_2k^(n+1) 
+                    const T delta_n1 = theta_cur[i + 1] - theta_cur[i + 2]; // Δυ_(2k+1)^(n+1)
 
-        if (!std::isfinite(delta2))
-            throw std::overflow_error("division by zero");
+                    theta_prev[i] = static_cast<T>(fma(delta_n * delta_n1, delta2, theta_prev[i + 1])); // υ_(2k+2)^(n)=υ_2k^(n+1)+((Δυ_2k^(n+1))*(Δυ_(2k+1)^(n+1)))/(Δ^2 υ_(2k+1)^(n)
+                }
+            }
 
-        const T delta_n = theta_order2_1 - theta(n, order2, S_n, 2); // Δυ_2k^(n+1) 
-        const T delta_n1 = theta_order1_1 - theta_order1_2; // Δυ_(2k+1)^(n+1)
+            std::swap(theta_prev, theta_cur);
+        }
 
-        return static_cast<T>(fma(delta_n * delta_n1, delta2, theta_order2_1)); // υ_(2k+2)^(n)=υ_2k^(n+1)+((Δυ_2k^(n+1))*(Δυ_(2k+1)^(n+1)))/(Δ^2 υ_(2k+1)^(n)
+        return theta_cur[0];
     }
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
+#include "two_row_tableau.h" // Include the two-row tableau
 #include <vector> // Include the vector library
 
  /**
@@ -46,11 +48,12 @@ public:
 
         K max = n - (n & 1); // int -> K mark 
 
-        std::vector<std::vector<T>> e(2, std::vector<T>(n, 0)); //2 vectors n length containing Epsilon table next and previous 
-        std::vector<T> f(n, 0); //vector for containing F results from 0 to n-1
+        two_row_tableau<T> e(n); //2 rows n length containing Epsilon table next and previous 
+        workspace_vector<T> f(n); //vector for containing F results from 0 to n-1
 
+        SHANKS_COUNT_CELLS(2 * max); // the first two rows
         for (K i = 0; i < max; ++i) //Counting first row of Epsilon Table
-            e[0][i] = static_cast<T>(1.0 / (this->series->operator()(i + 1)));
+            e.row(0)[i] = static_cast<T>(1.0 / (this->series->operator()(i + 1)));
 
         for (K i = 0; i < max; ++i) { //Counting F function
             i1 = i + 1;
@@ -65,30 +68,35 @@ public:
 
             down = this->series->operator()(i3) * coef2;
             down -= this->series->operator()(i1) * coef;
+            SHANKS_COUNT_DIVISION(down);
             down = static_cast<T>(1.0 / down);
 
-            e[1][i] = static_cast<T>(fma(-up, down, this->series->S_n(i1)));
+            e.row(1)[i] = static_cast<T>(fma(-up, down, this->series->S_n(i1)));
 
             f[i] = coef * coef2 * down; //Can make coeff2 ^2 for better effect
         }
 
         for (K k = 2; k <= max; ++k) { //Counting from 2 to n rows of Epsilon Table
             k1 = 1 - k;
+            T* const next = e.row(0);
+            const T* const previous = e.row(1);
             for (K i = 0; i < max - k; ++i) {
                 i1 = i + 1;
                 up = static_cast<T>(fma(k, f[i], k1));
-                down = static_cast<T>(1.0 / (e[1][i1] - e[1][i]));
-                e[0][i] = static_cast<T>(fma(up, down, e[0][i1]));
+                SHANKS_COUNT_CELLS(1);
+                SHANKS_COUNT_DIVISION(previous[i1] - previous[i]);
+                down = static_cast<T>(1.0 / (previous[i1] - previous[i]));
+                next[i] = static_cast<T>(fma(up, down, next[i1]));
 
-                if (!std::isfinite(e[0][i])) { //Check for invalid values to avoid them
+                if (!std::isfinite(next[i])) { //Check for invalid values to avoid them
                     max = k + i1;
                     break;
                 }
             }
-            std::swap(e[0], e[1]); //Swapping 1 and 2 rows of Epsilon Table. First ine will be overwriteen next turn
+            e.swap_rows(); //Swapping 1 and 2 rows of Epsilon Table. First ine will be overwriteen next turn
         }
 
-        const T result = e[max & 1][0]; //Only odd rows have mathmatical scence. Always returning e[0][0]
+        const T result = e.row(max & 1)[0]; //Only odd rows have mathmatical scence. Always returning e[0][0]
 
         if (!std::isfinite(result))
             throw std::overflow_error("division by zero");
@@ -0,0 +1,52 @@
+/**
+ * @file counting_series.h
+ * @brief This file contains the series decorator counting the evaluations of the terms, see instrumentation.h
+ */
+
+#pragma once
+
+#include "instrumentation.h" // Include the counters
+#include "series.h"          // Include the series header
+#include <memory>            // Include the memory library for std::unique_ptr
+#include <utility>           // Include the utility library for std::move
+
+/**
+ * @brief Series with the terms of another series, every call of operator() is counted as a term evaluation
+ * The partial sums are memoized by the decorator itself, so the terms they take are counted too.
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class counting_series : public series_base<T, K>
+{
+public:
+	counting_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the decorator with the counted series
+	* @param series The counted series, it's owned by the decorator
+	*/
+	explicit counting_series(std::unique_ptr<series_base<T, K>> series);
+
+	/**
+	* @brief Computes nth term of the counted series
+	* @param n The number of the term
+	* @return nth term of the counted series
+	*/
+	[[nodiscard]] constexpr virtual T operator()(K n) const;
+
+private:
+	/**
+	* @brief the counted series
+	*/
+	const std::unique_ptr<series_base<T, K>> series;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+counting_series<T, K>::counting_series(std::unique_ptr<series_base<T, K>> series) : series_base<T, K>(series->get_x(), series->get_sum()), series(std::move(series)) {}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr T counting_series<T, K>::operator()(K n) const
+{
+	SHANKS_COUNT_TERMS(1);
+	return series->operator()(n);
+}
@@ -5,6 +5,7 @@
 */
 
 #include "series_acceleration.h" // Include the series header
+#include "row_kernels.h" // Include the vectorized row updates
 #include <vector> // Include the vector library
 
 /**
@@ -31,6 +32,7 @@ protected:
 		T numerator = T(0), denominator = T(0);
 		T w_n, rest, a1;
 
+		SHANKS_COUNT_CELLS(n + 1);
 		for (K j = 0; j <= n; ++j) {
 			rest = this->series->minus_one_raised_to_power_n(j) * this->series->binomial_coefficient(static_cast<T>(n), j);
 			w_n = remainder_func->operator()(order, j, this->series, 1);
@@ -40,6 +42,7 @@ protected:
 			denominator += a1;
 		}
 
+		SHANKS_COUNT_DIVISION(denominator);
 		numerator /= denominator;
 
 		if (!std::isfinite(numerator))
@@ -58,7 +61,7 @@ protected:
 	T calculate_rec(const K n, const K order) const {
 		//TODO   ,    ,    
 		const K n1 = n + 1;
-		K orderi, j1;
+		K orderi;
 
 		std::vector<T> N (n1, 0);
 		std::vector<T> D (n1, 0);
@@ -69,13 +72,12 @@ protected:
 			N[i] = this->series->S_n(orderi) * D[i];
 		}
 
-		for (K i = 1; i <= n; ++i)
-			for (K j = 0; j <= n - i; ++j) {
-				j1 = j + 1;
-				D[j] = D[j1] - D[j];
-				N[j] = N[j1] - N[j];
-			}
+		for (K i = 1; i <= n; ++i) {
+			difference_row(D.data(), n - i + 1);
+			difference_row(N.data(), n - i + 1);
+		}
 
+		SHANKS_COUNT_DIVISION(D[0]);
 		const T numerator = N[0] / D[0];
 
 		if (!std::isfinite(numerator))
@@ -107,4 +109,46 @@ public:
 	T operator()(const K n, const K order) const {
 		return recursive ? calculate_rec(n, order) : calculate(n, order);
 	}
+
+	/**
+   * @brief D-transformation for all partial sums up to nth.
+   * With the reccurence formula T_i is the ith level of the same difference table, so it is built only once.
+   * @param n The largest number of terms in the partial sum.
+   * @param order The order of transformation.
+   * @return Vector of the partial sums after the transformation, see series_acceleration::transform_all.
+   */
+
+	std::vector<T> transform_all(const K n, const K order) const {
+		if (!recursive)
+			return series_acceleration<T, K, series_templ>::transform_all(n, order);
+
+		std::vector<T> result(n + 1, std::numeric_limits<T>::quiet_NaN());
+
+		std::vector<T> N;
+		std::vector<T> D;
+		N.reserve(n + 1);
+		D.reserve(n + 1);
+
+		// if the remainder is undefined for the term order + i, T_i and all further ones are undefined as well
+		try {
+			for (K i = 0; i <= n; ++i) {
+				D.push_back(remainder_func->operator()(0, order + i, this->series));
+				N.push_back(this->series->S_n(order + i) * D.back());
+			}
+		}
+		catch (std::overflow_error&) {}
+
+		const K size = static_cast<K>(D.size());
+
+		for (K i = 1; i < size; ++i) {
+			difference_row(D.data(), size - i);
+			difference_row(N.data(), size - i);
+
+			const T numerator = N[0] / D[0];
+			if (std::isfinite(numerator))
+				result[i] = numerator;
+		}
+
+		return result;
+	}
 };
\ No newline at end of file
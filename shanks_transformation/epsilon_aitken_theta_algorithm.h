@@ -5,6 +5,7 @@
  */
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
 #include <vector> // Include the vector library
 
  /**
@@ -36,7 +37,7 @@ public:
         if (n < 4)
             return 0;
 
-        std::vector<T> current(n);
+        workspace_vector<T> current(n);
 
         for (K i = 0; i < n; i++)
             current[i] = this->series->operator()(i);
@@ -44,13 +45,11 @@ public:
         T delta, delta_next;
         T gamma, lambda;
         T ck;
+        T step1_i, step1_i1;
 
         K i1, i2;
 
         for (K k = 1; k <= n; ++k) { //   n  iter,  iter - ,    ,     ,   iter > 1    0
-            std::vector<T> step1(n, T(0));
-            std::vector<T> step3(n, T(0));
-
             if (order == 1) {
                 gamma = T(1) / 2 / k;
                 lambda = T(1) - gamma;
@@ -64,32 +63,36 @@ public:
                 lambda = k * gamma;
             }
 
-            /*
-            T c_i1, c_i2, c_i3;
-            T s1_i, s1_i1, s1_i2;
-            */
-
             ck = T(1) + static_cast<T>(
                 (order == 1) ? order / (2 * k - 1) :
                 (order == 2) ? 1 / (3 * k - 2) :
                 order / k
                 );
 
-            step1[0] = current[1] - ck * (current[1] - current[0]) / (current[2] - current[1]);
+            // the Aitken, theta and relaxation steps are fused into one pass over current:
+            // the Aitken step is needed only at i and i + 1, and the result for i is written over current[i], which is not read after that
+            SHANKS_COUNT_CELLS(n - 3);
+            SHANKS_COUNT_DIVISION(current[2] - current[1]);
+            step1_i = current[1] - ck * (current[1] - current[0]) / (current[2] - current[1]);
 
-            for (K i = 0; i < K(step3.size() - 3); ++i) {
+            for (K i = 0; i < n - 3; ++i) {
                 i1 = i + 1;
                 i2 = i + 2;
 
-                step1[i1] = current[i2] - ck * (current[i2] - current[i1]) / (current[i2 + 1] - current[i2]);
+                SHANKS_COUNT_DIVISION(current[i2 + 1] - current[i2]);
+                step1_i1 = current[i2] - ck * (current[i2] - current[i1]) / (current[i2 + 1] - current[i2]);
 
-                delta = step1[i1] - step1[i];
+                delta = step1_i1 - step1_i;
 
-                delta_next = (i2 < K(step1.size())) ? step1[i2] - step1[i1] : T(0);
+                delta_next = T(0) - step1_i1; // the Aitken step at i + 2 is not computed yet at this point, so it is taken as zero
 
-                step3[i] = gamma * step1[i] + lambda * (step1[i1] + (delta * delta_next) / (delta - delta_next));
+                SHANKS_COUNT_DIVISION(delta - delta_next);
+                current[i] = gamma * step1_i + lambda * (step1_i1 + (delta * delta_next) / (delta - delta_next));
+
+                step1_i = step1_i1;
             }
-            current = step3;
+
+            current[n - 3] = current[n - 2] = current[n - 1] = T(0);
         }
 
         const T res = current[n - 4];
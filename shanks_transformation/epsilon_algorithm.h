@@ -4,6 +4,8 @@
  */
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
+#include "row_kernels.h" // Include the vectorized row updates
 #include <vector> // Include the vector library
 
  /**
@@ -32,6 +34,15 @@ public:
      * @return The partial sum after the transformation.
      */
     T operator()(const K n, const K order) const;
+
+	/**
+     * @brief Shanks multistep epsilon algorithm for all partial sums up to nth.
+     * The results for all n lie in the same column 2 * order of the epsilon table, so the table is built only once.
+     * @param n The largest number of terms in the partial sum.
+     * @param order The order of transformation.
+     * @return Vector of the partial sums after the transformation, see series_acceleration::transform_all.
+     */
+	std::vector<T> transform_all(const K n, const K order) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K, typename series_templ>
@@ -43,34 +54,70 @@ T epsilon_algorithm<T, K, series_templ>::operator()(const K n, const K order) co
 	if (order == 0)
 		return this->series->S_n(n);
 
+	if (n == 0)
+		throw std::domain_error("zero integer in the input");
+
 	const K m = 2 * order;
-	K max_ind = m + n; // int -> K mark
 
 	//TODO   ,    ,    
 	const K n1 = n - 1;
 
-	std::vector<T> e0(max_ind + 1, 0);
-	std::vector<T> e1(max_ind,     0);
+	// eps_m^(n1) depends only on the elements n1, ..., n1 + m + 1 of the column 0, so the columns are kept from the element n1 on:
+	// the element t of a column k is eps_k^(n1 + t)
+	const K width = m + 2;
 
-	auto e0_add = &e0; // Pointer for vector swapping
-	auto e1_add = &e1; // Pointer for vector swapping
+	workspace_vector<T> e0(width, 0);
+	workspace_vector<T> e1(width, 0); // the column -1 is zero
 
-	K j = max_ind;
-	do {
-		e0[j] = this->series->S_n(j);
-	} while (--j > 0);
+	for (K t = 0; t < width; ++t)
+		e0[t] = this->series->S_n(n1 + t);
 
-	for (K i = 0; i < m; ++i) {
-		for (K j = n1; j < max_ind; ++j)
-			(*e1_add)[j] += static_cast<T>(1.0 / ((*e0_add)[j + 1] - (*e0_add)[j]));
+	if (n1 == 0)
+		e0[0] = 0; // the column 0 starts with 0
 
-		--max_ind;
-		std::swap(e0_add, e1_add);
-		(*e1_add).erase((*e1_add).begin());
+	// e1 holds the column i - 1 and is overwritten by the column i + 1, e1[t] reads only e1[t + 1], which is not written yet
+	for (K i = 0; i < m; ++i) {
+		wynn_row(e1.data(), e1.data(), e0.data(), width - 1 - i);
+		std::swap(e0, e1);
 	}
 
-	if (!std::isfinite((*e0_add)[n1]))
+	if (!std::isfinite(e0[0]))
 		throw std::overflow_error("division by zero");
 
-	return (*e0_add)[n1];
-}
\ No newline at end of file
+	return e0[0];
+}
+
+template <std::floating_point T, std::unsigned_integral K, typename series_templ>
+std::vector<T> epsilon_algorithm<T, K, series_templ>::transform_all(const K n, const K order) const
+{
+	std::vector<T> result(n + 1, std::numeric_limits<T>::quiet_NaN());
+
+	if (order == 0) {
+		for (K i = 1; i <= n; ++i)
+			result[i] = this->series->S_n(i);
+		return result;
+	}
+
+	if (n == 0)
+		return result;
+
+	const K m = 2 * order;
+	const K max_ind = m + n - 1; // T_n is the element n - 1 of the column m, it depends on the elements up to n - 1 + m of the column 0
+
+	workspace_vector<T> e0(max_ind + 1, 0); // the column 0 starts with 0 like in operator()
+	workspace_vector<T> e1(max_ind + 1, 0);
+
+	for (K j = 1; j <= max_ind; ++j)
+		e0[j] = this->series->S_n(j);
+
+	for (K i = 0; i < m; ++i) {
+		wynn_row(e1.data(), e1.data(), e0.data(), max_ind - i);
+		std::swap(e0, e1);
+	}
+
+	for (K i = 1; i <= n; ++i)
+		if (std::isfinite(e0[i - 1]))
+			result[i] = e0[i - 1];
+
+	return result;
+}
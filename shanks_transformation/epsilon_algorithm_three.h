@@ -94,10 +94,15 @@ public:
                         break;
                     }
 
+                    SHANKS_COUNT_DIVISION(DELTA1);
+                    SHANKS_COUNT_DIVISION(DELTA2);
+                    SHANKS_COUNT_DIVISION(DELTA3);
                     SS = static_cast<T>(1.0 / DELTA1 + 1.0 / DELTA2 - 1.0 / DELTA3);
                     EPSINF = std::abs(SS * E1);
 
                     if (EPSINF > epsilon_threshold) {
+                        SHANKS_COUNT_CELLS(1);
+                        SHANKS_COUNT_DIVISION(SS);
                         RES = static_cast<T>(E1 + 1.0 / SS);
                         e[K1] = RES;
                         K1 -= 2;
@@ -7,6 +7,8 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
+#include "row_kernels.h" // Include the vectorized row updates
 #include <vector> // Include the vector library
 
  /**
@@ -52,7 +54,7 @@ T epsilon_algorithm_two<T, K, series_templ>::operator()(const K n, const K order
 
     K k = 2 * order + n - (n & 1);
 
-    std::vector<std::vector<T>> e(4, std::vector<T>(k + 3, 0)); //4 vectors k+3 length containing four Epsilon Table rows 
+    workspace_vector<T> e[4] = { workspace_vector<T>(k + 3), workspace_vector<T>(k + 3), workspace_vector<T>(k + 3), workspace_vector<T>(k + 3) }; //4 vectors k+3 length containing four Epsilon Table rows 
 
     K j = k;
     do { //Counting first row of Epsilon Table
@@ -64,8 +66,10 @@ T epsilon_algorithm_two<T, K, series_templ>::operator()(const K n, const K order
     //TODO   ,    ,    
     K i1, i2;
 
-    while (k > -1) {
-        for (K i = 0; i < k; ++i) {
+    do { // k runs down to 0 inclusive, K is unsigned so the loop tests k before decrementing it
+        // the standard elements are computed by packs, the elements of a pack with a corrupted one are recomputed here in order
+        wynn_row_checked(e[0].data(), e[2].data(), e[3].data(), k, [&](const std::size_t t) {
+            const K i = static_cast<K>(t);
             i1 = i + 1;
             i2 = i + 2;
             e[0][i] = static_cast<T>(e[2][i1] + 1.0 / (e[3][i1] - e[3][i])); //Standart Epsilon Wynn algorithm
@@ -81,13 +85,11 @@ T epsilon_algorithm_two<T, K, series_templ>::operator()(const K n, const K order
             }
             if (!std::isfinite(e[0][i])) //If new element is still corrupted we just copy prev. element, so we will get result
                 e[0][i] = e[2][i];         
-        }
+        });
         std::swap(e[0], e[1]); //Swapping rows of Epsilon Table. First ine will be overwriteen next turn
         std::swap(e[1], e[2]);
         std::swap(e[2], e[3]);
-
-        --k;
-    }
+    } while (k-- > 0);
     
     if (!std::isfinite(e[0][0]))
         throw std::overflow_error("division by zero");
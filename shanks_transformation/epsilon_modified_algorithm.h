@@ -4,6 +4,7 @@
  */
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
 #include <vector> // Include the vector library
 
  /**
@@ -26,36 +27,38 @@ public:
 	/**
 	 * @brief modified Epsilon Algorithm
 	 * Computes the partial sum after the transformation using the epsilon_modified_algorithm
+	 * The column k of the table depends only on the column k - 1: eps[m][k] = eps[m - 1][k - 1] + 1 / (eps[m][k - 1] - eps[m - 1][k - 1]) / c_k,
+	 * so a single column is kept and updated in place from m = n - 1 down to m = k.
 	 * @param n The number of terms in the partial sum.
 	 * @param order The order of transformation.
 	 * @return The partial sum after the transformation.
 	 */
 
 	T operator()(const K n, const K order) const {
+		if (n == 0)
+			throw std::domain_error("zero integer in the input");
 
-		std::vector<std::vector<T>> eps(n, std::vector<T>(n, 0));
-
-		//std::vector<std::vector<T>> e(2, std::vector<T>(n, 0)); //2 vectors n length containing Epsilon table next and previous 
+		workspace_vector<T> eps(n);
 
 		for (K i = 0; i < n; ++i)
-			eps[i][0] = this->series->operator()(i);
+			eps[i] = this->series->operator()(i);
 
-		K m1, k1;
+		for (K k = 1; k < n; ++k) {
+			const T scale = (k & 1) ? order + T(k + 1) / 2 : T(2) / (k + 2);
 
-		for (K k = 1; k < n; ++k)
-			for (K m = k; m < n; ++m) {
-				m1 = m - 1;
-				k1 = k - 1;
-				eps[m][k] = eps[m1][k1] + T(1) / (eps[m][k1] - eps[m1][k1]) / ((k & 1) ? order + T(k + 1) / 2 : T(2) / (k + 2));
+			SHANKS_COUNT_CELLS(n - k);
+			for (K m = n - 1; m >= k; --m) {
+				SHANKS_COUNT_DIVISION(eps[m] - eps[m - 1]);
+				eps[m] = eps[m - 1] + T(1) / (eps[m] - eps[m - 1]) / scale;
 
-				//       ,   k1 - 1,  k1, 
+				//     eps[m - 1]   k - 2  k - 1,
 				//     ,           ,    
-				//eps[m][k] = eps[m1][k1 - 1] + T(1) / (eps[m][k1] - eps[m1][k1]) / ((k & 1) ? order + T(k + 1) / 2 : T(2) / (k + 2));
 			}
+		}
 
-		if (!std::isfinite(eps[n - 1][n - 1]))
+		if (!std::isfinite(eps[n - 1]))
 			throw std::overflow_error("division by zero");
 
-		return eps[n - 1][n - 1];
+		return eps[n - 1];
 	}
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @file instrumentation.h
+ * @brief This file contains the opt-in counters of the work done by the transformations
+ * When SHANKS_INSTRUMENTATION is defined, every thread counts the terms evaluated through counting_series, the S_n calls,
+ * the computed cells of the tables and the divisions by a denominator not greater than the machine epsilon of its type.
+ * The counts of a transformation call are taken with counters_scope. Without SHANKS_INSTRUMENTATION the SHANKS_COUNT_*
+ * macros expand to nothing and their arguments are not evaluated.
+ * The Levin-type transformations sum order + 1 (or n + 1) weighted terms instead of filling a table, so every term of
+ * the sum is counted as a cell and the division by the sum of the weights as a division.
+ * The terms are evaluated only when the memoized partial sums of the series are extended, so when several
+ * transformations share a series, as in test_all_transforms, a term is counted by the one that needs it first.
+ * Then the term counts depend on the order of the calls, the other counts are still per call.
+ */
+
+#pragma once
+
+#include <cmath>   // Include the cmath library for std::abs
+#include <limits>  // Include the limits library for std::numeric_limits
+
+/**
+ * @brief Counts of the work done by the transformations
+ */
+struct transform_counters
+{
+	unsigned long long term_evaluations = 0;    // calls of the terms of a counting_series
+	unsigned long long partial_sums = 0;        // calls of series_base::S_n
+	unsigned long long table_cells = 0;         // computed elements of the tables
+	unsigned long long near_zero_divisions = 0; // divisions by |x| <= epsilon
+
+	transform_counters operator-(const transform_counters& other) const
+	{
+		return { term_evaluations - other.term_evaluations, partial_sums - other.partial_sums,
+			table_cells - other.table_cells, near_zero_divisions - other.near_zero_divisions };
+	}
+};
+
+/**
+ * @brief Whether the counters are compiled in
+ */
+#ifdef SHANKS_INSTRUMENTATION
+constexpr bool instrumentation_enabled = true;
+#else
+constexpr bool instrumentation_enabled = false;
+#endif
+
+/**
+ * @brief The counters of the calling thread, they only grow
+ * @return The counters
+ */
+inline transform_counters& thread_counters()
+{
+	thread_local transform_counters counters;
+	return counters;
+}
+
+/**
+ * @brief Counts the division by the denominator if it is near zero
+ * @param denominator The denominator
+ */
+template <typename T>
+inline void count_division(const T denominator)
+{
+	if (!(std::abs(denominator) > std::numeric_limits<T>::epsilon()))
+		++thread_counters().near_zero_divisions;
+}
+
+#ifdef SHANKS_INSTRUMENTATION
+#define SHANKS_COUNT_TERMS(count) (thread_counters().term_evaluations += (count))
+#define SHANKS_COUNT_PARTIAL_SUMS(count) (thread_counters().partial_sums += (count))
+#define SHANKS_COUNT_CELLS(count) (thread_counters().table_cells += (count))
+#define SHANKS_COUNT_DIVISION(denominator) count_division(denominator)
+#else
+#define SHANKS_COUNT_TERMS(count) ((void)0)
+#define SHANKS_COUNT_PARTIAL_SUMS(count) ((void)0)
+#define SHANKS_COUNT_CELLS(count) ((void)0)
+#define SHANKS_COUNT_DIVISION(denominator) ((void)0)
+#endif
+
+/**
+ * @brief Takes the counts of the calling thread made during the lifetime of the scope
+ */
+class counters_scope
+{
+public:
+	counters_scope() : start(thread_counters()) {}
+
+	/**
+	* @brief The counts made since the construction of the scope
+	* @return The counts, all zero without SHANKS_INSTRUMENTATION
+	*/
+	[[nodiscard]] transform_counters counters() const { return thread_counters() - start; }
+
+private:
+	const transform_counters start;
+};
@@ -7,6 +7,7 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "weight_cache.h" // Include the cache of the weights
 #include <vector> // Include the vector library
 
  /**
@@ -43,22 +44,22 @@ public:
 		if (order == 0)
 			return this->series->S_n(n);
 
-		T numerator = 0, denominator = 0, C_njk, S_nj, g_n, rest;
+		const auto weights = weight_cache<T, K>::instance().get(levin_weights, n, order, T(0), [&]() { return calculate_weights(n, order); });
 
-		for (K j = 0; j <= order; ++j) { //Standart Levin algo procedure
-			rest = this->series->minus_one_raised_to_power_n(j) * this->series->binomial_coefficient(static_cast<T>(order), j);
-
-			C_njk = static_cast<T>((std::pow((n + j + 1), (order - 1))) / (std::pow((n + order + 1), (order - 1))));
+		T numerator = 0, denominator = 0, S_nj, g_n, rest;
 
+		SHANKS_COUNT_CELLS(order + 1);
+		for (K j = 0; j <= order; ++j) { //Standart Levin algo procedure
 			S_nj = this->series->S_n(n + j);
 
 			g_n = 1 / (this->series->operator()(n + j));
 
-			rest *= C_njk * g_n;
+			rest = (*weights)[j] * ((*weights)[order + 1 + j] * g_n);
 
 			denominator += rest;
 			numerator += rest * S_nj;
 		}
+		SHANKS_COUNT_DIVISION(denominator);
 		numerator /= denominator;
 
 		if (!std::isfinite(numerator))
@@ -66,4 +67,25 @@ public:
 
 		return numerator;
 	}
+
+private:
+	/**
+	 * @brief Function to calculate the factors (-1)^j * C(order, j) and (n + j + 1)^(order - 1) / (n + order + 1)^(order - 1) of the Levin algorithm.
+	 * They do not depend on the series, so operator() takes them from weight_cache.
+	 * They are kept apart, so operator() multiplies them with the remainder in the same order as the direct formula.
+	 * @param n The number of terms in the partial sum.
+	 * @param order The order of transformation.
+	 * @return Vector of 2 * (order + 1) factors, the signed binomial coefficients followed by the ratios of the powers.
+	 */
+
+	static std::vector<T> calculate_weights(const K n, const K order) {
+		std::vector<T> weights(2 * (order + 1), 0);
+
+		for (K j = 0; j <= order; ++j) {
+			weights[j] = series_base<T, K>::minus_one_raised_to_power_n(j) * series_base<T, K>::binomial_coefficient(static_cast<T>(order), j);
+			weights[order + 1 + j] = static_cast<T>((std::pow((n + j + 1), (order - 1))) / (std::pow((n + order + 1), (order - 1))));
+		}
+
+		return weights;
+	}
 };
\ No newline at end of file
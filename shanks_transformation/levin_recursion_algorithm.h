@@ -41,36 +41,44 @@ public:
         if (order == 0)
             return this->series->S_n(n);
 
-        const T result = (*this)(n, order, beta, 0) / (*this)(n, order, beta, 1);
+        // the numerators and denominators share the weights and the recurrence, so both tables are filled together:
+        // N_0^(n+i) = S_(n+i) / w_(n+i), D_0^(n+i) = 1 / w_(n+i), where w_m = (-1)^m * m!,
+        // X_k^(m) = X_(k-1)^(m+1) - (b + m) * (b + m + k - 1)^(k-2) / (b + m + k)^(k-1) * X_(k-1)^(m)
+        // the result N_order^(n) / D_order^(n) does not change if all weights are multiplied by (-1)^n * n!,
+        // so 1 / w_(n+i) is replaced with (-1)^i * n! / (n+i)! taken from the table of log((n+i)! / n!), which does not overflow
+        std::vector<T> N(order + 1, 0);
+        std::vector<T> D(order + 1, 0);
 
-        if (!std::isfinite(result))
-            throw std::overflow_error("division by zero");
+        T log_fact = T(0);
+        for (K i = 0; i <= order; ++i) {
+            if (i != 0)
+                log_fact += std::log(static_cast<T>(n + i));
 
-        return result;
-    }
-private:
-    const T beta;
+            D[i] = (i & 1 ? T(-1) : T(1)) * std::exp(-log_fact);
+            N[i] = this->series->S_n(n + i) * D[i];
+        }
 
-    T operator()(const K n_time, const K k_time, const T b, const bool ND) const {
-        T w_n = static_cast<T>(pow(T(-1), n_time) * this->series->fact(n_time));
-        T R_0 = (ND == 0 ? this->series->S_n(n_time) : T(1)) / w_n;
+        T a2, a3, factor;
+        for (K k = 1; k <= order; ++k) {
+            SHANKS_COUNT_CELLS(2 * (order - k + 1));
+            for (K i = 0; i <= order - k; ++i) {
+                a2 = static_cast<T>(beta + n + i);
+                a3 = static_cast<T>(a2 + k - 1);
+                factor = static_cast<T>(pow(a3, static_cast<T>(k) - 2) / pow(a3 + 1, static_cast<T>(k) - 1));
 
-        if (k_time == 0)
-            return R_0;
+                N[i] = static_cast<T>(fma(-a2 * N[i], factor, N[i + 1]));
+                D[i] = static_cast<T>(fma(-a2 * D[i], factor, D[i + 1]));
+            }
+        }
 
-        const K a1 = k_time - 1;
-        const T a2 = static_cast<T>(b + n_time);
-        const T a3 = static_cast<T>(a1 + a2);
+        SHANKS_COUNT_DIVISION(D[0]);
+        const T result = N[0] / D[0];
 
-        const T res = static_cast<T>(fma(
-            -a2 * (*this)(n_time, a1, b, ND),
-            pow(a3, a1 - 1) / pow(a3 + 1, a1),
-            (*this)(n_time + 1, a1, b, ND)
-        ));
-
-        if (!std::isfinite(res))
+        if (!std::isfinite(result))
             throw std::overflow_error("division by zero");
 
-        return res;
+        return result;
     }
+private:
+    const T beta;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "weight_cache.h" // Include the cache of the weights
 #include <vector>
 #include <memory> // For std::unique_ptr
 
@@ -40,41 +41,25 @@ protected:
 		if (gamma <= n - 1)
 			throw std::domain_error("gamma cannot be lesser than n-1");
 
+		const auto weights = weight_cache<T, K>::instance().get(M_levin_sidi_weights, n, order, gamma, [&]() { return calculate_weights(n, order); });
+
 		T numerator = T(0), denominator = T(0);
-		T w_n, rest;
-		T up = T(1), down = T(1);
+		T w_n;
 
-		T binomial_coef = this->series->binomial_coefficient(static_cast<T>(n), 0);
 		T S_n = this->series->S_n(order);
 
 		T rest_w_n;
-		T down_coef = static_cast<T>(gamma + order + 2), up_coef = down_coef - n;
 
 		//TODO   ,    ,    
 		K j1;
-		
-		for (K m = 0; m < n - 1; ++m) {
-			up *= (up_coef + m);
-			down *= (down_coef + m);
-		}
 
-		up /= down;
-		down_coef = static_cast<T>(gamma + order + 1);
-		up_coef = (down_coef - n + 1);
-		
+		SHANKS_COUNT_CELLS(n + 1);
 		for (K j = 0; j <= n; ++j) {
 			j1 = j + 1;
-			rest = this->series->minus_one_raised_to_power_n(j) * binomial_coef;
-
-			binomial_coef = binomial_coef * (n - j) / j1;
-
-			rest *= up;
-
-			up /= (up_coef + j) * ( down_coef + j);
 
 			w_n = remainder_func->operator()(order, j, this->series, static_cast<T>(-gamma - n));
 
-			rest_w_n = rest * w_n;
+			rest_w_n = (*weights)[j] * w_n;
 
 			numerator += rest_w_n * S_n ;
 
@@ -83,6 +68,7 @@ protected:
 			denominator += rest_w_n;
 		}
 
+		SHANKS_COUNT_DIVISION(denominator);
 		numerator /= denominator;
 
 		if (!std::isfinite(numerator))
@@ -91,6 +77,45 @@ protected:
 		return numerator;
 	}
 
+	/**
+	 * @brief Function to calculate the weights of the M-transformation: (-1)^j * C(n, j) and the ratio of the Pochhammer symbols.
+	 * They do not depend on the series, so calculate takes them from weight_cache.
+	 * @param n The number of terms in the partial sum.
+	 * @param order the order of transformation
+	 * @return Vector of n + 1 weights.
+	 */
+
+	std::vector<T> calculate_weights(const K n, const K order) const {
+		std::vector<T> weights(n + 1, 0);
+		T up = T(1), down = T(1);
+
+		T binomial_coef = series_base<T, K>::binomial_coefficient(static_cast<T>(n), 0);
+
+		T down_coef = static_cast<T>(gamma + order + 2), up_coef = down_coef - n;
+
+		K j1;
+
+		for (K m = 0; m < n - 1; ++m) {
+			up *= (up_coef + m);
+			down *= (down_coef + m);
+		}
+
+		up /= down;
+		down_coef = static_cast<T>(gamma + order + 1);
+		up_coef = (down_coef - n + 1);
+
+		for (K j = 0; j <= n; ++j) {
+			j1 = j + 1;
+			weights[j] = series_base<T, K>::minus_one_raised_to_power_n(j) * binomial_coef * up;
+
+			binomial_coef = binomial_coef * (n - j) / j1;
+
+			up /= (up_coef + j) * ( down_coef + j);
+		}
+
+		return weights;
+	}
+
 public:
 
 	/**
@@ -7,6 +7,8 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "weight_cache.h" // Include the cache of the weights
+#include "row_kernels.h" // Include the vectorized row updates
 #include <vector> // Include the vector library
 
 /**
@@ -39,16 +41,49 @@ protected:
 		if (beta == 0)
 			throw std::domain_error("beta cannot be initiared by a zero");
 
+		const auto weights = weight_cache<T, K>::instance().get(levi_sidi_S_weights, n, order, beta, [&]() { return calculate_weights(n, order); });
+
 		T numerator = T(0), denominator = T(0);
-		T w_n, rest;
+		T w_n, a5;
+
+		SHANKS_COUNT_CELLS(n + 1);
+		for (K j = 0; j <= n; ++j) {
+			w_n = remainder_func->operator()(n, j, this->series, static_cast<T>(beta + n));
+
+			a5 = (*weights)[j] * w_n;
+
+			numerator += a5 * this->series->S_n(order + j);
+			denominator += a5;
+		}
+
+		SHANKS_COUNT_DIVISION(denominator);
+		numerator /= denominator;
+
+		if (!std::isfinite(numerator))
+			throw std::overflow_error("division by zero");
+
+		return numerator;
+	}
+
+	/**
+	* @brief Function to calculate the weights (-1)^j * C(n, j) * (beta + order + j)_(n-1) / (beta + order + n)_(n-1) of the S-tranformation.
+	* They do not depend on the series, so calculate takes them from weight_cache.
+	* @param n The number of terms in the partial sum.
+	* @param order the order of transformation
+	* @return Vector of n + 1 weights.
+	*/
+
+	std::vector<T> calculate_weights(const K n, const K order) const {
+		std::vector<T> weights(n + 1, 0);
+		T rest;
 		T up, down;
 
-		T a1, a2, a3, a4, a5;
+		T a1, a2, a3, a4;
 		a1 = beta + order;
 		a2 = a1 + n;
 
 		for (K j = 0; j <= n; ++j) {
-			rest = this->series->minus_one_raised_to_power_n(j) * this->series->binomial_coefficient(static_cast<T>(n), j);
+			rest = series_base<T, K>::minus_one_raised_to_power_n(j) * series_base<T, K>::binomial_coefficient(static_cast<T>(n), j);
 
 			up = down = T(1);
 
@@ -59,22 +94,10 @@ protected:
 				down *= a4;
 			}
 
-			rest *= (up / down);
-
-			w_n = remainder_func->operator()(n, j, this->series, static_cast<T>(beta + n));
-
-			a5 = rest * w_n;
-
-			numerator += a5 * this->series->S_n(order + j);
-			denominator += a5;
+			weights[j] = rest * (up / down);
 		}
 
-		numerator /= denominator;
-
-		if (!std::isfinite(numerator))
-			throw std::overflow_error("division by zero");
-
-		return numerator;
+		return weights;
 	}
 
 	/**
@@ -102,7 +125,6 @@ protected:
 		}
 
 		T b1, b2, b3, b4, b5, b6;
-		K j1;
 
 		b1 = beta + order;
 		b2 = b1 - 1;
@@ -112,17 +134,10 @@ protected:
 			b4 = b2 + i;
 			b5 = b3 + i;
 			b6 = b4 + i;
-			for (K j = 0; j <= n - i; ++j) { 
-				T scale1 = (b3 + j) * (b4 + j);
-				T scale2 = b5 * (b6 + j);
-
-				j1 = j + 1;
-
-				D[j] = fma(-scale1, D[j] / scale2, D[j1]);
-				N[j] = fma(-scale1, N[j] / scale2, N[j1]);
-			}
+			levin_sidi_row(D.data(), N.data(), n - i + 1, b3, b4, b5, b6);
 		}
 
+		SHANKS_COUNT_DIVISION(D[0]);
 		T numerator = N[0] / D[0];
 
 		if (!std::isfinite(numerator))
@@ -7,7 +7,8 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
-#include <vector>
+#include <vector> // Include the vector library
+#include <limits> // Include the limits library for the NaN marking undefined values
 
 /**
  * @brief W_transformation class template.
@@ -24,48 +25,46 @@ protected:
 	/**
 	 * @brief Default function to calculate W-tranformation. 
 	 * For more information see p. 290 15.4.1 [http://servidor.demec.ufpr.br/CFD/bibliografia/MER/Sidi_2003.pdf]
+	 * W_k^(m) is computed from W_(k-1)^(m), ..., W_(k-1)^(m+3), so the table is filled order by order:
+	 * the column k is needed on [n, n + 3 * (order - k)] and overwrites the column k - 1 in place.
+	 * The first element of the column k is the transformation of order k, so all orders come from one table.
 	 * @authors Yurov P.I. Bezzaborov A.A.
 	 * @param n The number of terms in the partial sum.
 	 * @param order the order of transformation
-	 * @return The partial sum after the transformation.
+	 * @return Vector of order + 1 elements, kth of them is the partial sum after the transformation of order k or NaN if it is undefined.
 	 */
 
-	T calculate(K n, const K order, T S_n, const K j) const {
-		/*
-		* j - to fix n
-		* S_n - partial sum of series.
-		*/
-		for (K i = 0; i < j; ++i) 
-			S_n += this->series->operator()(n + 1 + i);
-		
-		n += j;
-		if (order == 0) 
-			return S_n;
-
-		//calculate all basic parts of transfor
-
-		//TODO   ,    ,    
-		K order1 = order - 1;
-		T W0 = calculate(n, order1, S_n, 0);
-		T W1 = calculate(n, order1, S_n, 1);
-		T W2 = calculate(n, order1, S_n, 2);
-		T W3 = calculate(n, order1, S_n, 3);
-		
-		//optimization calculations
-		T Wo0 = (W1 - W0);
-		T Wo1 = (W2 - W1);
-		T Wo2 = (W3 - W2);
-		T Woo1 = Wo0 * (Wo2 - Wo1);
-		T Woo2 = Wo2 * (Wo1 - Wo0);
-
-		//T result = W1 - ((W2 - W1) * (W1 - W0) * (W3 - 2 * W2 + W1)) / ((W3 - W2) * (W2 - 2 * W1 + W0) - (W1 - W0) * (W3 - 2 * W2 + W1)); //straigh
-		const T result = fma(-Wo1, Woo1 / (Woo2 - Woo1), W1); // optimized
+	std::vector<T> calculate(const K n, const K order) const {
+		std::vector<T> result(order + 1, std::numeric_limits<T>::quiet_NaN());
+		std::vector<T> W(3 * order + 1, 0);
 
-		if (!std::isfinite(result))
-			throw std::overflow_error("division by zero");
+		for (K i = 0; i <= 3 * order; ++i)
+			W[i] = this->series->S_n(n + i);
 
-		return result;
+		result[0] = W[0];
+
+		T Wo0, Wo1, Wo2, Woo1, Woo2;
+		for (K k = 1; k <= order; ++k) {
+			SHANKS_COUNT_CELLS(3 * (order - k) + 1);
+			for (K i = 0; i <= 3 * (order - k); ++i) {
+				//optimization calculations
+				Wo0 = (W[i + 1] - W[i]);
+				Wo1 = (W[i + 2] - W[i + 1]);
+				Wo2 = (W[i + 3] - W[i + 2]);
+				Woo1 = Wo0 * (Wo2 - Wo1);
+				Woo2 = Wo2 * (Wo1 - Wo0);
+
+				//W[i] = W1 - ((W2 - W1) * (W1 - W0) * (W3 - 2 * W2 + W1)) / ((W3 - W2) * (W2 - 2 * W1 + W0) - (W1 - W0) * (W3 - 2 * W2 + W1)); //straigh
+				SHANKS_COUNT_DIVISION(Woo2 - Woo1);
+				W[i] = fma(-Wo1, Woo1 / (Woo2 - Woo1), W[i + 1]); // optimized
+			}
 
+			// a non-finite element with i > 0 only feeds the higher orders, so only W[0] decides whether the order k is defined
+			if (std::isfinite(W[0]))
+				result[k] = W[0];
+		}
+
+		return result;
 	}
 public:
 
@@ -90,6 +89,23 @@ public:
 		if (order < 0) 
 			throw std::domain_error("negative order input");
 
-		return calculate(n, order, this->series->S_n(n), 0);
+		const T result = calculate(n, order)[order];
+
+		if (!std::isfinite(result))
+			throw std::overflow_error("division by zero");
+
+		return result;
+	}
+
+	/**
+     * @brief W-transformations of all orders up to order.
+     * Computes the partial sums after the W-transformations of orders 0, ..., order with one table
+     * @param n The number of terms in the partial sum.
+     * @param order The largest order of transformation.
+     * @return Vector of order + 1 elements, kth of them is the partial sum after the transformation of order k or NaN if it is undefined.
+     */
+
+	std::vector<T> all_orders(const K n, const K order) const {
+		return calculate(n, order);
 	}
 };
\ No newline at end of file
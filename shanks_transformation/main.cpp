@@ -6,9 +6,13 @@
  * 2) Series base class and its subclasses in series.h. They are the ones being accelerated
  * 3) Testing functions in test_functions.h. Functions that can be called in main to test how series_acceleration and series_base subclasses work and cooperate.
  * 4) Framework for testing in test_framework.h
+ * 5) span_series in span_series.h. It lets any transformation run directly on partial sums or terms already held in the caller's memory
+ * 6) Streaming transformations in streaming_acceleration.h. They are given the terms one by one and keep the transformed partial sum up to date
+ * 7) Benchmark of all transformations in benchmark.cpp, built as the separate shanks_benchmark target. It prints the timings as CSV or JSON
  * It is recommended you look up doxygen documentation on our repository https://katerina-evdokimova.github.io/shanks-university/ to convinently figure out what's everything for
  */
 #include "test_framework.h"
+#include "allocation_hooks.h"
 
 int main(void)
 {
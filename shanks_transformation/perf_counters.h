@@ -0,0 +1,152 @@
+/**
+ * @file perf_counters.h
+ * @brief This file contains the hardware performance counters of the calling thread read through Linux perf_event_open
+ * The cycles, the instructions, the cache misses and the branch misses of the user space are counted as one group.
+ * The counters may be missing: perf_event_open is Linux only, it can be forbidden by kernel.perf_event_paranoid or by
+ * a container, and a virtual machine may have no PMU. A counter that can't be opened reads as NaN, so the callers fall
+ * back to the timings only. When the kernel multiplexes the counters, the counts are scaled to the enabled time.
+ */
+
+#pragma once
+
+#include <cstddef> // Include the cstddef library for std::size_t
+#include <cstdint> // Include the cstdint library for std::uint64_t
+#include <limits>  // Include the limits library for std::numeric_limits
+
+#if defined(__linux__)
+#include <linux/perf_event.h> // Include the perf_event library for perf_event_attr
+#include <sys/ioctl.h>        // Include the ioctl library for the control of the counters
+#include <sys/syscall.h>      // Include the syscall library for SYS_perf_event_open
+#include <unistd.h>           // Include the unistd library for syscall, read and close
+#include <cstring>            // Include the cstring library for std::memset
+#endif
+
+/**
+ * @brief Counts of the hardware events, NaN for the events that are not counted
+ */
+struct hardware_sample
+{
+	double cycles = std::numeric_limits<double>::quiet_NaN();
+	double instructions = std::numeric_limits<double>::quiet_NaN();
+	double cache_misses = std::numeric_limits<double>::quiet_NaN();
+	double branch_misses = std::numeric_limits<double>::quiet_NaN();
+};
+
+/**
+ * @brief Group of the hardware counters of the calling thread
+ */
+class hardware_counters
+{
+public:
+	/**
+	* @brief Opens the counters, the ones that can't be opened are left out
+	*/
+	hardware_counters();
+
+	hardware_counters(const hardware_counters&) = delete;
+	hardware_counters& operator=(const hardware_counters&) = delete;
+
+	/**
+	* @brief Closes the counters
+	*/
+	~hardware_counters();
+
+	/**
+	* @brief Whether at least one counter is open
+	* @return true if something is counted
+	*/
+	[[nodiscard]] bool available() const { return fds[0] >= 0; }
+
+	/**
+	* @brief Resets the counters to zero and starts counting
+	*/
+	void start();
+
+	/**
+	* @brief Stops counting and reads the counts since start
+	* @return The counts, all NaN if the counters are not available
+	*/
+	hardware_sample stop();
+
+private:
+	static constexpr std::size_t events = 4; // cycles, instructions, cache misses, branch misses
+
+	int fds[events] = { -1, -1, -1, -1 }; // the descriptors of the open counters are first, the group leader is fds[0]
+	std::size_t kinds[events] = {};       // the event of the counter fds[i]
+	std::size_t open = 0;                 // amount of the open counters
+};
+
+#if defined(__linux__)
+
+inline hardware_counters::hardware_counters()
+{
+	static constexpr std::uint64_t configs[events] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+	for (std::size_t kind = 0; kind < events; ++kind) {
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = configs[kind];
+		attr.disabled = open == 0; // the group is enabled and disabled through its leader
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, open == 0 ? -1 : fds[0], 0));
+		if (fd < 0)
+			continue;
+
+		fds[open] = fd;
+		kinds[open] = kind;
+		++open;
+	}
+}
+
+inline hardware_counters::~hardware_counters()
+{
+	for (std::size_t i = 0; i < open; ++i)
+		close(fds[i]);
+}
+
+inline void hardware_counters::start()
+{
+	if (!available())
+		return;
+
+	ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+inline hardware_sample hardware_counters::stop()
+{
+	hardware_sample sample;
+	if (!available())
+		return sample;
+
+	ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// nr, time_enabled, time_running, then the values in the order the counters were opened
+	std::uint64_t data[3 + events] = {};
+	if (read(fds[0], data, sizeof(data)) < static_cast<ssize_t>((3 + open) * sizeof(std::uint64_t)) || data[2] == 0)
+		return sample;
+
+	const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+	double* const values[events] = { &sample.cycles, &sample.instructions, &sample.cache_misses, &sample.branch_misses };
+	for (std::size_t i = 0; i < open && i < data[0]; ++i)
+		*values[kinds[i]] = static_cast<double>(data[3 + i]) * scale;
+
+	return sample;
+}
+
+#else
+
+inline hardware_counters::hardware_counters() {}
+
+inline hardware_counters::~hardware_counters() {}
+
+inline void hardware_counters::start() {}
+
+inline hardware_sample hardware_counters::stop() { return {}; }
+
+#endif
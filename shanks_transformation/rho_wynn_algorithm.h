@@ -9,6 +9,7 @@
 
 #include "series_acceleration.h" // Include the series header
 #include <memory> // For std::unique_ptr
+#include <vector> // Include the vector library
 
  /**
   * @brief Rho Wynn Algorithm class template.
@@ -24,6 +25,15 @@ protected:
 	const T gamma;
 	const T RHO;
 
+	/**
+	* @brief Function to calculate the rho table column by column
+	* rho_k^(m) = (rho_{k-2}^(m+1) + C(m, k)) / (rho_{k-1}^(m+1) - rho_{k-1}^(m)), where rho_0^(m) = S_m, rho_{-1}^(m) = 0 and C is the numerator.
+	* The result rho_order^(n) depends on the elements rho_k^(m) with n <= m <= n + order - k, each of them is computed once,
+	* only two columns are kept: the column k overwrites the column k - 2 in place.
+	* @param n The number of terms in the partial sum.
+	* @param order The order of transformation.
+	* @return The partial sum after the transformation.
+	*/
 	T calculate(const K n, K order) const { //const int order
 		if (order & 1) { // is order odd
 			++order;
@@ -33,44 +43,27 @@ protected:
 		if (order == 0)
 			return this->series->S_n(n);
 
-		const T S_n = this->series->S_n(n);
+		std::vector<T> rho_prev(order + 1, 0); // column k - 2, the column -1 is zero
+		std::vector<T> rho_cur(order + 1, 0);  // column k - 1
 
-		//TODO   ,    ,    
-		const K order1 = order - 1;
+		for (K i = 0; i <= order; ++i)
+			rho_cur[i] = this->series->S_n(n + i);
 
-		const T res = (recursive_calculate_body(n, order1 - 1, S_n, 1) + numerator_func->operator()(n, order, this->series, gamma, RHO)) / 
-			(recursive_calculate_body(n, order1, S_n, 1) - recursive_calculate_body(n, order1, S_n, 0));
+		for (K k = 1; k <= order; ++k) {
+			SHANKS_COUNT_CELLS(order - k + 1);
+			for (K i = 0; i <= order - k; ++i) {
+				SHANKS_COUNT_DIVISION(rho_cur[i + 1] - rho_cur[i]);
+				rho_prev[i] = (rho_prev[i + 1] + numerator_func->operator()(n + i, k, this->series, gamma, RHO)) / (rho_cur[i + 1] - rho_cur[i]);
 
-		if (!std::isfinite(res))
-			throw std::overflow_error("division by zero");
+				if (!std::isfinite(rho_prev[i]))
+					throw std::overflow_error("division by zero");
+			}
+			std::swap(rho_prev, rho_cur);
+		}
 
-		return res;
+		return rho_cur[0];
 	}
 
-	T recursive_calculate_body(const K n, const K order, T S_n, const K j) const {
-		/**
-		* S_n - previous sum;
-		* j - adjusts n: (n + j);
-		*/
-		S_n += (j == K(0)) ? T(0) : this->series->operator()(n + j);
-		if (order == 0)
-			return S_n;
-
-		if (order == -1)
-			return 0;
-
-		//TODO   ,    ,    
-		const K order1 = order - 1;
-		const K nj = n + j;
-
-		const T res = (recursive_calculate_body(nj, order1 - 1, S_n, 1) + numerator_func->operator()(nj, order, this->series, gamma, RHO)) /
-			(recursive_calculate_body(nj, order1, S_n, 1) - recursive_calculate_body(nj, order1, S_n, 0));
-
-		if (!std::isfinite(res))
-			throw std::overflow_error("division by zero");
-
-		return res;
-	}
 public:
 	/**
      * @brief Parameterized constructor to initialize the Rho Wynn Algorithm.
@@ -7,6 +7,8 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "two_row_tableau.h" // Include the two-row tableau
+#include "row_kernels.h" // Include the vectorized row updates
 #include <vector> // Include the vector library
 
  /**
@@ -36,10 +38,10 @@ public:
         if (n == 0)
             return DEF_UNDEFINED_SUM;
 
-        std::vector<std::vector<T>> e(2, std::vector<T>(n + 1, 0)); //2 vectors n + 1 length containing Richardson table next and previous 
+        two_row_tableau<T> e(n + 1); //2 rows n + 1 length containing Richardson table next and previous 
 
         for (K i = 0; i <= n; ++i)
-            e[0][i] = this->series->S_n(i);
+            e.row(0)[i] = this->series->S_n(i);
 
         // The Richardson method main function 
         T a, b;
@@ -48,17 +50,47 @@ public:
         for (K l = 1; l <= n; ++l) {
             a *= 4;
             b = a - 1;
-            for (K m = l; m <= n; ++m)
-                e[1][m] = fma(a, e[0][m], -e[0][m - 1]) / b;
-
-            std::swap(e[0], e[1]);
+            richardson_row(e.row(0), e.row(1), l, n, a, b);
+            e.swap_rows();
         }
 
-        const T res = e[n & 1][n]; // get n & 1, cause if n is even, result is e[0][n], if n is odd, result is e[1][n]
+        const T res = e.row(n & 1)[n]; // get n & 1, cause if n is even, result is e[0][n], if n is odd, result is e[1][n]
 
         if (!std::isfinite(res))
             throw std::overflow_error("division by zero");
 
         return res;
     }
+
+     /**
+      * @brief Richardson transformation for all partial sums up to nth.
+      * operator() for n reads the element n of the nth level of the table, so all of them are taken from one table.
+      * @param n The largest number of terms in the partial sum.
+      * @param order The order of transformation.
+      * @return Vector of the partial sums after the transformation, see series_acceleration::transform_all.
+      */
+    std::vector<T> transform_all(const K n, [[maybe_unused]] const K order) const {
+        std::vector<T> result(n + 1, std::numeric_limits<T>::quiet_NaN());
+
+        two_row_tableau<T> e(n + 1);
+
+        for (K i = 0; i <= n; ++i)
+            e.row(0)[i] = this->series->S_n(i);
+
+        T a, b;
+        a = static_cast<T>(1);
+
+        for (K l = 1; l <= n; ++l) {
+            a *= 4;
+            b = a - 1;
+            richardson_row(e.row(0), e.row(1), l, n, a, b);
+            e.swap_rows();
+
+            const T res = e.row(l & 1)[l]; // the same element operator() returns for n = l
+            if (std::isfinite(res))
+                result[l] = res;
+        }
+
+        return result;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,424 @@
+/**
+ * @file row_kernels.h
+ * @brief This file contains the vectorized row updates of the tableau-based transformations
+ * Every kernel updates a row of a table element by element with simd_pack<T, isa> and finishes the row with the
+ * scalar formula of the transformation, so the results are the same as of the scalar loops they replace.
+ * The kernels are compiled for every instruction set, the functions at the end of the file call the ones
+ * of the instruction set chosen by simd_selected_isa().
+ */
+
+#pragma once
+
+#include "instrumentation.h" // Include the counters of the work done
+#include "simd_dispatch.h" // Include the choice of the instruction set
+#include <cmath>       // Include the cmath library for fma and std::isfinite
+#include <concepts>    // Include the concepts library for std::floating_point
+#include <cstddef>     // Include the cstddef library for std::size_t
+#include <type_traits> // Include the type_traits library for std::is_same_v
+
+/**
+ * @brief Whether the fused kernels may run with the packs of isa
+ * The float formulas call the double fma in places (unqualified fma, integer arguments) and round the result to float
+ * afterwards, a fused float operation would round once, so only the double packs are used.
+ * @tparam T The type of the elements, isa The instruction set
+ */
+template <std::floating_point T, simd_isa_t isa>
+constexpr bool simd_fused_kernels = simd_pack<T, isa>::has_fma && std::is_same_v<T, double>;
+
+/**
+ * @brief Wynn's epsilon rule along a row: out[t] = lower[t + s] + 1 / (upper[t + s] - upper[t]), t = 0, ..., count - 1
+ * s is 1 for a single table and the amount of lanes for the tables of several series stored lane by lane.
+ * out may be lower, out[t] is written after lower[t + s] is read.
+ * @param out The computed row
+ * @param lower The row two columns back
+ * @param upper The previous row
+ * @param count The amount of computed elements
+ * @param s The distance between neighbouring elements of the row
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void wynn_row_kernel(T* out, const T* lower, const T* upper, const std::size_t count, const std::size_t s)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t t = 0;
+
+	if constexpr (pack::width > 1) {
+		const pack one = pack::broadcast(T(1));
+		for (; t + pack::width <= count; t += pack::width)
+			(pack::load(lower + t + s) + one / (pack::load(upper + t + s) - pack::load(upper + t))).store(out + t);
+	}
+
+	for (; t < count; ++t)
+		out[t] = lower[t + s] + static_cast<T>(1.0 / (upper[t + s] - upper[t]));
+}
+
+/**
+ * @brief Wynn's epsilon rule along a row with a fallback for the elements that are not finite
+ * The elements are computed by packs, a pack with a non-finite element is discarded and element(t) is called
+ * for each of its elements in order instead, as well as for the elements after the last full pack.
+ * The scalar formula of epsilon_algorithm_two adds in double before rounding to T, so only the double packs are used.
+ * @param out The computed row
+ * @param lower The row two columns back
+ * @param upper The previous row
+ * @param count The amount of computed elements
+ * @param element Functor computing out[t] with the scalar formula and its fallback
+ */
+template <std::floating_point T, simd_isa_t isa, typename Element>
+SHANKS_SIMD_INLINE void wynn_row_checked_kernel(T* out, const T* lower, const T* upper, const std::size_t count, Element&& element)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t t = 0;
+
+	if constexpr (pack::width > 1 && std::is_same_v<T, double>) {
+		const pack one = pack::broadcast(T(1));
+		for (; t + pack::width <= count; t += pack::width) {
+			const pack value = pack::load(lower + t + 1) + one / (pack::load(upper + t + 1) - pack::load(upper + t));
+			if (all_finite(value))
+				value.store(out + t);
+			else
+				for (std::size_t i = t; i < t + pack::width; ++i)
+					element(i);
+		}
+	}
+
+	for (; t < count; ++t)
+		element(t);
+}
+
+/**
+ * @brief Forward differences along a row in place: x[j] = x[j + 1] - x[j], j = 0, ..., count - 1
+ * @param x The row
+ * @param count The amount of computed elements
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void difference_row_kernel(T* x, const std::size_t count)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t j = 0;
+
+	if constexpr (pack::width > 1)
+		for (; j + pack::width <= count; j += pack::width)
+			(pack::load(x + j + 1) - pack::load(x + j)).store(x + j);
+
+	for (; j < count; ++j)
+		x[j] = x[j + 1] - x[j];
+}
+
+/**
+ * @brief Level of the Richardson table: next[m] = (a * previous[m] - previous[m - 1]) / b, m = first, ..., last
+ * @param previous The previous level
+ * @param next The computed level
+ * @param first The first computed element, at least 1
+ * @param last The last computed element
+ * @param a 4^l
+ * @param b 4^l - 1
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void richardson_row_kernel(const T* previous, T* next, const std::size_t first, const std::size_t last, const T a, const T b)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t m = first;
+
+	if constexpr (simd_fused_kernels<T, isa>) {
+		const pack A = pack::broadcast(a);
+		const pack B = pack::broadcast(b);
+		for (; m + pack::width <= last + 1; m += pack::width)
+			(fms(A, pack::load(previous + m), pack::load(previous + m - 1)) / B).store(next + m);
+	}
+
+	for (; m <= last; ++m)
+		next[m] = fma(a, previous[m], -previous[m - 1]) / b;
+}
+
+/**
+ * @brief Level of the Levin-Sidi S recurrence in place, for j = 0, ..., count - 1:
+ * X[j] = X[j + 1] - (b3 + j) * (b4 + j) * X[j] / (b5 * (b6 + j)) for X = D and X = N
+ * @param D The denominators
+ * @param N The numerators
+ * @param count The amount of computed elements
+ * @param b3, b4, b5, b6 The shifts of the level
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void levin_sidi_row_kernel(T* D, T* N, const std::size_t count, const T b3, const T b4, const T b5, const T b6)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t j = 0;
+
+	if constexpr (simd_fused_kernels<T, isa>) {
+		const pack B3 = pack::broadcast(b3);
+		const pack B4 = pack::broadcast(b4);
+		const pack B5 = pack::broadcast(b5);
+		const pack B6 = pack::broadcast(b6);
+		for (; j + pack::width <= count; j += pack::width) {
+			const pack J = pack::sequence(static_cast<T>(j));
+			const pack scale1 = (B3 + J) * (B4 + J);
+			const pack scale2 = B5 * (B6 + J);
+
+			fnma(scale1, pack::load(D + j) / scale2, pack::load(D + j + 1)).store(D + j);
+			fnma(scale1, pack::load(N + j) / scale2, pack::load(N + j + 1)).store(N + j);
+		}
+	}
+
+	for (; j < count; ++j) {
+		const T scale1 = (b3 + j) * (b4 + j);
+		const T scale2 = b5 * (b6 + j);
+
+		D[j] = fma(-scale1, D[j] / scale2, D[j + 1]);
+		N[j] = fma(-scale1, N[j] / scale2, N[j + 1]);
+	}
+}
+
+/**
+ * @brief The first level of the Shanks transformation, for t = 0, ..., count - 1:
+ * out[t] = S[t] + a[t] * a[t + s] * (a[t] + a[t + s]) / (a[t]^2 - a[t + s]^2), the squares taken with fma like in shanks_transform
+ * @param out The computed level
+ * @param a The terms
+ * @param S The partial sums
+ * @param count The amount of computed elements
+ * @param s The distance between neighbouring terms
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void aitken_row_kernel(T* out, const T* a, const T* S, const std::size_t count, const std::size_t s)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t t = 0;
+
+	if constexpr (simd_fused_kernels<T, isa>) {
+		for (; t + pack::width <= count; t += pack::width) {
+			const pack a_n = pack::load(a + t);
+			const pack a_n_plus_1 = pack::load(a + t + s);
+			const pack square = a_n_plus_1 * a_n_plus_1;
+
+			fma(a_n * a_n_plus_1, (a_n + a_n_plus_1) / (fms(a_n, a_n, square) - fms(a_n_plus_1, a_n_plus_1, square)), pack::load(S + t)).store(out + t);
+		}
+	}
+
+	for (; t < count; ++t) {
+		const T a_n = a[t];
+		const T a_n_plus_1 = a[t + s];
+		const T tmp = -a_n_plus_1 * a_n_plus_1;
+
+		out[t] = std::fma(a_n * a_n_plus_1, (a_n + a_n_plus_1) / (std::fma(a_n, a_n, tmp) - std::fma(a_n_plus_1, a_n_plus_1, tmp)), S[t]);
+	}
+}
+
+/**
+ * @brief The next level of the Shanks transformation, for t = 0, ..., count - 1 with a = x[t], b = x[t - s], c = x[t + s]:
+ * out[t] = a - (a - b) * (c - a) / (c - 2 * a + b), computed with fma like in shanks_transform
+ * @param out The computed level
+ * @param x The previous level, x[-s] must exist
+ * @param count The amount of computed elements
+ * @param s The distance between neighbouring elements of the level
+ */
+template <std::floating_point T, simd_isa_t isa>
+SHANKS_SIMD_INLINE void shanks_row_kernel(T* out, const T* x, const std::size_t count, const std::size_t s)
+{
+	using pack = simd_pack<T, isa>;
+	std::size_t t = 0;
+
+	if constexpr (simd_fused_kernels<T, isa>) {
+		const pack one = pack::broadcast(T(1));
+		const pack two = pack::broadcast(T(2));
+		for (; t + pack::width <= count; t += pack::width) {
+			const pack a = pack::load(x + t);
+			const pack b = pack::load(x + t - s);
+			const pack c = pack::load(x + t + s);
+
+			fma(fms(a, c + b - a, b * c), one / fms(two, a, b + c), a).store(out + t);
+		}
+	}
+
+	for (; t < count; ++t) {
+		const T a = x[t];
+		const T b = x[t - s];
+		const T c = x[t + s];
+
+		out[t] = static_cast<T>(std::fma(std::fma(a, c + b - a, -b * c), 1 / (std::fma(2, a, -b - c)), a));
+	}
+}
+
+/**
+ * @brief The kernels of the instruction set isa, compiled for it
+ * @tparam T The type of the elements, isa The instruction set
+ */
+template <std::floating_point T, simd_isa_t isa>
+struct row_kernel_set;
+
+#define SHANKS_ROW_KERNEL_SET(isa, target) \
+template <std::floating_point T> \
+struct row_kernel_set<T, isa> \
+{ \
+	target static void wynn_row(T* out, const T* lower, const T* upper, const std::size_t count, const std::size_t s) { \
+		wynn_row_kernel<T, isa>(out, lower, upper, count, s); \
+	} \
+	target static void wynn_row_checked(T* out, const T* lower, const T* upper, const std::size_t count, void (*element)(void*, std::size_t), void* context) { \
+		wynn_row_checked_kernel<T, isa>(out, lower, upper, count, [element, context](const std::size_t t) { element(context, t); }); \
+	} \
+	target static void difference_row(T* x, const std::size_t count) { \
+		difference_row_kernel<T, isa>(x, count); \
+	} \
+	target static void richardson_row(const T* previous, T* next, const std::size_t first, const std::size_t last, const T a, const T b) { \
+		richardson_row_kernel<T, isa>(previous, next, first, last, a, b); \
+	} \
+	target static void levin_sidi_row(T* D, T* N, const std::size_t count, const T b3, const T b4, const T b5, const T b6) { \
+		levin_sidi_row_kernel<T, isa>(D, N, count, b3, b4, b5, b6); \
+	} \
+	target static void aitken_row(T* out, const T* a, const T* S, const std::size_t count, const std::size_t s) { \
+		aitken_row_kernel<T, isa>(out, a, S, count, s); \
+	} \
+	target static void shanks_row(T* out, const T* x, const std::size_t count, const std::size_t s) { \
+		shanks_row_kernel<T, isa>(out, x, count, s); \
+	} \
+};
+
+SHANKS_ROW_KERNEL_SET(simd_scalar, )
+SHANKS_ROW_KERNEL_SET(simd_sse42, SHANKS_TARGET_SSE42)
+SHANKS_ROW_KERNEL_SET(simd_avx2, SHANKS_TARGET_AVX2)
+SHANKS_ROW_KERNEL_SET(simd_avx512, SHANKS_TARGET_AVX512)
+
+#undef SHANKS_ROW_KERNEL_SET
+
+/**
+ * @brief Dispatch table of the kernels for the elements of type T, filled once with the kernels of simd_selected_isa()
+ * @tparam T The type of the elements
+ */
+template <std::floating_point T>
+struct row_kernel_table
+{
+	void (*wynn_row)(T*, const T*, const T*, std::size_t, std::size_t);
+	void (*wynn_row_checked)(T*, const T*, const T*, std::size_t, void (*)(void*, std::size_t), void*);
+	void (*difference_row)(T*, std::size_t);
+	void (*richardson_row)(const T*, T*, std::size_t, std::size_t, T, T);
+	void (*levin_sidi_row)(T*, T*, std::size_t, T, T, T, T);
+	void (*aitken_row)(T*, const T*, const T*, std::size_t, std::size_t);
+	void (*shanks_row)(T*, const T*, std::size_t, std::size_t);
+
+	/**
+	* @brief The table of the selected instruction set
+	* @return Reference to the table
+	*/
+	static const row_kernel_table& instance();
+
+private:
+	template <simd_isa_t isa>
+	static constexpr row_kernel_table of() {
+		using set = row_kernel_set<T, isa>;
+		return { &set::wynn_row, &set::wynn_row_checked, &set::difference_row, &set::richardson_row, &set::levin_sidi_row, &set::aitken_row, &set::shanks_row };
+	}
+};
+
+template <std::floating_point T>
+const row_kernel_table<T>& row_kernel_table<T>::instance()
+{
+	static const row_kernel_table table = [] {
+		switch (simd_selected_isa()) {
+#if defined(SHANKS_SIMD_X86)
+		case simd_avx512:
+			return of<simd_avx512>();
+		case simd_avx2:
+			return of<simd_avx2>();
+		case simd_sse42:
+			return of<simd_sse42>();
+#endif
+		default:
+			return of<simd_scalar>();
+		}
+	}();
+
+	return table;
+}
+
+/**
+ * @brief Wynn's epsilon rule along a row, see wynn_row_kernel
+ */
+template <std::floating_point T>
+void wynn_row(T* out, const T* lower, const T* upper, const std::size_t count, const std::size_t s = 1)
+{
+	if constexpr (instrumentation_enabled) {
+		SHANKS_COUNT_CELLS(count);
+		for (std::size_t t = 0; t < count; ++t)
+			SHANKS_COUNT_DIVISION(upper[t + s] - upper[t]);
+	}
+
+	row_kernel_table<T>::instance().wynn_row(out, lower, upper, count, s);
+}
+
+/**
+ * @brief Wynn's epsilon rule along a row with a fallback for the elements that are not finite, see wynn_row_checked_kernel
+ */
+template <std::floating_point T, typename Element>
+void wynn_row_checked(T* out, const T* lower, const T* upper, const std::size_t count, Element&& element)
+{
+	if constexpr (instrumentation_enabled) {
+		SHANKS_COUNT_CELLS(count);
+		for (std::size_t t = 0; t < count; ++t)
+			SHANKS_COUNT_DIVISION(upper[t + 1] - upper[t]);
+	}
+
+	const auto call = [](void* context, const std::size_t t) { (*static_cast<std::remove_reference_t<Element>*>(context))(t); };
+	row_kernel_table<T>::instance().wynn_row_checked(out, lower, upper, count, call, &element);
+}
+
+/**
+ * @brief Forward differences along a row in place, see difference_row_kernel
+ */
+template <std::floating_point T>
+void difference_row(T* x, const std::size_t count)
+{
+	SHANKS_COUNT_CELLS(count);
+	row_kernel_table<T>::instance().difference_row(x, count);
+}
+
+/**
+ * @brief Level of the Richardson table, see richardson_row_kernel
+ */
+template <std::floating_point T>
+void richardson_row(const T* previous, T* next, const std::size_t first, const std::size_t last, const T a, const T b)
+{
+	SHANKS_COUNT_CELLS(last + 1 - first);
+	row_kernel_table<T>::instance().richardson_row(previous, next, first, last, a, b);
+}
+
+/**
+ * @brief Level of the Levin-Sidi S recurrence in place, see levin_sidi_row_kernel
+ */
+template <std::floating_point T>
+void levin_sidi_row(T* D, T* N, const std::size_t count, const T b3, const T b4, const T b5, const T b6)
+{
+	if constexpr (instrumentation_enabled) {
+		SHANKS_COUNT_CELLS(2 * count);
+		for (std::size_t j = 0; j < count; ++j)
+			SHANKS_COUNT_DIVISION(b5 * (b6 + j));
+	}
+
+	row_kernel_table<T>::instance().levin_sidi_row(D, N, count, b3, b4, b5, b6);
+}
+
+/**
+ * @brief The first level of the Shanks transformation, see aitken_row_kernel
+ */
+template <std::floating_point T>
+void aitken_row(T* out, const T* a, const T* S, const std::size_t count, const std::size_t s)
+{
+	if constexpr (instrumentation_enabled) {
+		SHANKS_COUNT_CELLS(count);
+		for (std::size_t t = 0; t < count; ++t)
+			SHANKS_COUNT_DIVISION(std::fma(a[t], a[t], -a[t + s] * a[t + s]) - std::fma(a[t + s], a[t + s], -a[t + s] * a[t + s]));
+	}
+
+	row_kernel_table<T>::instance().aitken_row(out, a, S, count, s);
+}
+
+/**
+ * @brief The next level of the Shanks transformation, see shanks_row_kernel
+ */
+template <std::floating_point T>
+void shanks_row(T* out, const T* x, const std::size_t count, const std::size_t s)
+{
+	if constexpr (instrumentation_enabled) {
+		SHANKS_COUNT_CELLS(count);
+		for (std::size_t t = 0; t < count; ++t)
+			SHANKS_COUNT_DIVISION(std::fma(2, x[t], -x[t - s] - x[t + s]));
+	}
+
+	row_kernel_table<T>::instance().shanks_row(out, x, count, s);
+}
@@ -113,6 +113,9 @@
 #include <limits>
 #include <vector>
 #include <concepts>
+#include "term_store.h"
+#include "instrumentation.h"
+#include "trace.h"
 
  /**
  * @brief Abstract class for series
@@ -134,12 +137,27 @@ public:
 
 	/**
 	* @brief Computes partial sum of the first n terms
+	* Partial sums are memoized: the first call extends the cache up to n, the following ones answer in O(1)
 	* @authors Bolshakov M.P.
 	* @param n The amount of terms in the partial sum
 	* @return Partial sum of the first n terms
 	*/
 	[[nodiscard]] constexpr T S_n(K n) const;
 
+	/**
+	* @brief Drops all memoized partial sums, so they are recomputed by the next S_n call
+	* Must not be called while the series is used by other threads
+	*/
+	void clear_partial_sums();
+
+	/**
+	* @brief Bounds the amount of memoized partial sums
+	* S_n beyond the limit is still correct, it is computed from the last memoized partial sum
+	* Must not be called while the series is used by other threads
+	* @param limit The maximum amount of partial sums kept in the cache
+	*/
+	void set_partial_sums_limit(K limit);
+
 	/**
 	* @brief Computes nth term of the series
 	* @authors Bolshakov M.P.
@@ -220,6 +238,19 @@ protected:
 	* @authors Bolshakov M.P.
 	*/
 	const T sum;
+
+private:
+	/**
+	* @brief memoized partial sums S_0, S_1, ..., extended on demand by S_n
+	* The store is safe to share between threads, so S_n can be called concurrently
+	*/
+	concurrent_term_store<T> partial_sums;
+
+	/**
+	* @brief the maximum amount of memoized partial sums
+	* It's unbounded by default
+	*/
+	K partial_sums_limit = std::numeric_limits<K>::max();
 };
 
 template <std::floating_point T, std::unsigned_integral K>
@@ -231,12 +262,37 @@ series_base<T, K>::series_base(T x, T sum) : x(x), sum(sum) {}
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T series_base<T, K>::S_n(K n) const
 {
-	T sum = operator()(n);
-	for (K i = 0; i < n; ++i)
+	SHANKS_COUNT_PARTIAL_SUMS(1);
+
+	if (n < partial_sums.size())
+		return partial_sums[n];
+
+	SHANKS_TRACE_SCOPE("term generation");
+
+	const auto next_sum = [this](auto i, T previous) { return previous + operator()(static_cast<K>(i)); };
+
+	if (n < partial_sums_limit)
+		return partial_sums.extend_to(n, next_sum);
+
+	T sum = partial_sums_limit == 0 ? T(0) : partial_sums.extend_to(partial_sums_limit - 1, next_sum);
+	for (K i = partial_sums_limit; i <= n; ++i)
 		sum += operator()(i);
 	return sum;
 }
 
+template <std::floating_point T, std::unsigned_integral K>
+void series_base<T, K>::clear_partial_sums()
+{
+	partial_sums.clear();
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+void series_base<T, K>::set_partial_sums_limit(K limit)
+{
+	partial_sums_limit = limit;
+	partial_sums.truncate(limit);
+}
+
 template <std::floating_point T, std::unsigned_integral K>
 constexpr const T series_base<T, K>::get_x() const
 {
@@ -330,30 +386,25 @@ public:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	virtual T acsess_row(K n) = 0;
+	virtual T acsess_row(K n) const = 0;
 
 	/**
-	* @brief Vector, containing elements of the series
+	* @brief Store, containing elements of the series
+	* It is extended by acsess_row and can be shared between threads: readers of computed terms never block
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
-	* It's empty by default
 	* @authors Kreynin R.G.
 	*/
-	std::vector<T> series_vector;
+	concurrent_term_store<T> series_vector;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
-requrrent_series_base<T, K>::requrrent_series_base(T x)
-{
-	this->series_vector.push_back(x);
-};
+requrrent_series_base<T, K>::requrrent_series_base(T x) : series_vector(std::vector<T>{x}) {};
 
 template <std::floating_point T, std::unsigned_integral K>
-requrrent_series_base<T, K>::requrrent_series_base(std::vector<T> row)
+requrrent_series_base<T, K>::requrrent_series_base(std::vector<T> row) : series_vector(row)
 {
 	if (row.size() < 1)
 		throw std::domain_error("empty row imput");
-
-	this->series_vector = row;
 };
 
 
@@ -394,28 +445,24 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 exp_series<T, K>::exp_series(T x) : series_base<T, K>(x, std::exp(x)), requrrent_series_base<T, K>(T(1)) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T exp_series<T, K>::acsess_row(K n)
+T exp_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * this->x / i); // (1.2) [Rows.pdf]
-
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this](auto i, T previous) {
+		return previous * this->x / i; // (1.2) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T exp_series<T, K>::operator()(K n) const
 {
-	return const_cast<exp_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -454,31 +501,27 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 cos_series<T, K>::cos_series(T x) : series_base<T, K>(x, std::cos(x)), requrrent_series_base<T, K>(std::vector<T>{1, T(((-1) * x * x) / 2)}) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T cos_series<T, K>::acsess_row(K n)
+T cos_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	T a = static_cast<T>(-this->x * this->x);
-
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(a / (i * std::fma(4, i, -2)))); // (2.2) [Rows.pdf]
+	const T a = static_cast<T>(-this->x * this->x);
 
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this, a](auto i, T previous) {
+		return previous * static_cast<T>(a / (i * std::fma(4, i, -2))); // (2.2) [Rows.pdf]
+	});
 }
 
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T cos_series<T, K>::operator()(K n) const
 {
-	return const_cast<cos_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -517,30 +560,26 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 sin_series<T, K>::sin_series(T x) : series_base<T, K>(x, std::sin(x)), requrrent_series_base<T, K>(x) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T sin_series<T, K>::acsess_row(K n)
+T sin_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
+	const T a = static_cast<T>(-this->x * this->x);
 
-	T a = static_cast<T>(-this->x * this->x);
-
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(a / (i * std::fma(4, i, 2)))); // (3.2) [Rows.pdf]
-
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this, a](auto i, T previous) {
+		return previous * static_cast<T>(a / (i * std::fma(4, i, 2))); // (3.2) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T sin_series<T, K>::operator()(K n) const
 {
-	return const_cast<sin_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -579,30 +618,26 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 cosh_series<T, K>::cosh_series(T x) : series_base<T, K>(x, std::cosh(x)), requrrent_series_base<T, K>(std::vector<T>{1, T((x * x) / 2) }) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T cosh_series<T, K>::acsess_row(K n)
+T cosh_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	T a = static_cast<T>(this->x * this->x);
+	const T a = static_cast<T>(this->x * this->x);
 
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(a / (i * std::fma(4, i, -2)))); // (4.2) [Rows.pdf] 
-
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this, a](auto i, T previous) {
+		return previous * static_cast<T>(a / (i * std::fma(4, i, -2))); // (4.2) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T cosh_series<T, K>::operator()(K n) const
 {
-	return const_cast<cosh_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -641,30 +676,26 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 sinh_series<T, K>::sinh_series(T x) : series_base<T, K>(x, std::sinh(x)), requrrent_series_base<T, K>(x) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T sinh_series<T, K>::acsess_row(K n)
+T sinh_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	T a = static_cast<T>(this->x * this->x);
-
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(a / (i * std::fma(4, i, 2)))); // (5.2) [Rows.pdf]
+	const T a = static_cast<T>(this->x * this->x);
 
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this, a](auto i, T previous) {
+		return previous * static_cast<T>(a / (i * std::fma(4, i, 2))); // (5.2) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T sinh_series<T, K>::operator()(K n) const
 {
-	return const_cast<sinh_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -841,29 +872,25 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 mean_sinh_sin_series<T, K>::mean_sinh_sin_series(T x) : series_base<T, K>(x, static_cast<T>(static_cast<T>(0.5) * (std::sinh(x) + std::sin(x)))), requrrent_series_base<T, K>(x) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T mean_sinh_sin_series<T, K>::acsess_row(K n)
+T mean_sinh_sin_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-	T a;
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i) {
-		a = static_cast<T>(std::fma(4, i, 1));
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(std::pow(this->x, 4) / (4 * i * a * (a - 2) * (a - 3)))); // (9.1) [Rows.pdf]
-	}
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this](auto i, T previous) {
+		const T a = static_cast<T>(std::fma(4, i, 1));
+		return previous * static_cast<T>(std::pow(this->x, 4) / (4 * i * a * (a - 2) * (a - 3))); // (9.1) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T mean_sinh_sin_series<T, K>::operator()(K n) const
 {
-	return const_cast<mean_sinh_sin_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 
@@ -1119,33 +1146,27 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 erf_series<T, K>::erf_series(T x) : series_base<T, K>(x, static_cast<T>(std::sqrt(std::numbers::pi)) * static_cast<T>(std::erf(x) / 2)), requrrent_series_base<T, K>(x) { }
 
 template <std::floating_point T, std::unsigned_integral K>
-T erf_series<T, K>::acsess_row(K n)
+T erf_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-	T a;
-
-	T b = static_cast<T>(-this->x * this->x);
+	const T b = static_cast<T>(-this->x * this->x);
 
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i) 
-	{
-		a = static_cast<T>(std::fma(2, i, 1));
-		this->series_vector.push_back(this->series_vector[i - 1] * static_cast<T>(b * (a - 2) / (i * a))); // (15.3) [Rows.pdf]
-	}
-	return static_cast<T>(this->series_vector[n]);
+	return this->series_vector.extend_to(n, [this, b](auto i, T previous) {
+		const T a = static_cast<T>(std::fma(2, i, 1));
+		return previous * static_cast<T>(b * (a - 2) / (i * a)); // (15.3) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T erf_series<T, K>::operator()(K n) const
 {
-	return const_cast<erf_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -1190,7 +1211,7 @@ private:
 	* @tparam T The type of the elements in the series, K The type of enumerating integer
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
@@ -1204,21 +1225,17 @@ m_fact_1mx_mp1_inverse_series<T, K>::m_fact_1mx_mp1_inverse_series(T x, K m) : s
 }
 
 template <std::floating_point T, std::unsigned_integral K>
-T m_fact_1mx_mp1_inverse_series<T, K>::acsess_row(K n)
+T m_fact_1mx_mp1_inverse_series<T, K>::acsess_row(K n) const
 {
-	auto old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	for (auto i = old_size; i <= static_cast<typename std::vector<T>::size_type>(n); ++i)
-		this->series_vector.push_back(this->series_vector[i - 1] * this->x * (this->m + i) / i); // (16.2) [Rows.pdf]
-
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this](auto i, T previous) {
+		return previous * this->x * (this->m + i) / i; // (16.2) [Rows.pdf]
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T m_fact_1mx_mp1_inverse_series<T, K>::operator()(K n) const
 {
-	return const_cast<m_fact_1mx_mp1_inverse_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
 
 /**
@@ -4908,26 +4925,22 @@ private:
 	* @param n The number of the term
 	* @return nth term of the series
 	*/
-	T acsess_row(K n);
+	T acsess_row(K n) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K>
 requrrent_testing_series<T, K>::requrrent_testing_series(T x) : series_base<T, K>(x, 0), requrrent_series_base<T, K>(x) {}
 
 template <std::floating_point T, std::unsigned_integral K>
-T requrrent_testing_series<T, K>::acsess_row(K n)
+T requrrent_testing_series<T, K>::acsess_row(K n) const
 {
-	K old_size = this->series_vector.size();
-	this->series_vector.reserve(n);
-
-	for (K i = old_size; i <= n; ++i) 
-		this->series_vector.push_back(this->series_vector[i - 1] * (this->x * this->x) / (i * std::fma(4, i, 2)));
-
-	return this->series_vector[n];
+	return this->series_vector.extend_to(n, [this](auto i, T previous) {
+		return previous * (this->x * this->x) / (i * std::fma(4, i, 2));
+	});
 }
 
 template <std::floating_point T, std::unsigned_integral K>
 constexpr T requrrent_testing_series<T, K>::operator()(K n) const
 {
-	return const_cast<requrrent_testing_series<T, K>*>(this)->acsess_row(n);
+	return this->acsess_row(n);
 }
\ No newline at end of file
@@ -14,6 +14,8 @@
 #include <exception>  // Include the exception library for std::exception
 #include <math.h>     // Include the math library for mathematical functions
 #include <string>	  // Include the library which contains the string class
+#include <vector>	  // Include the vector library
+#include <limits>	  // Include the limits library for the NaN marking undefined values
 #include "series.h"
 
 
@@ -39,8 +41,9 @@ public:
 	/**
    * @brief Method for printing out the info about the object of this class
    * @authors Bolshakov M.P.
+   * @param out The stream to print to
    */
-	constexpr void print_info() const;
+	constexpr void print_info(std::ostream& out = std::cout) const;
 
 	/**
    * @brief Virtual operator() that returns the partial sum after transformation of the series
@@ -51,6 +54,16 @@ public:
    */
 	virtual T operator()(const K n, const K order) const = 0;
 
+	/**
+   * @brief Computes the transformed partial sums T_1, ..., T_n of one order at once
+   * The default implementation calls operator() for every i, the transformations built on a table override it
+   * to fill the table only once instead of rebuilding it for every i.
+   * @param n The largest number of terms
+   * @param order The order of the transformation
+   * @return Vector of n + 1 elements, ith of them is T_i; the element 0 and the elements for which the transformation is undefined (e.g. due to division by zero) are NaN
+   */
+	virtual std::vector<T> transform_all(const K n, const K order) const;
+
 protected:
 	/**
    * @brief Series whose convergence is being accelerated
@@ -63,7 +76,23 @@ template <std::floating_point T, std::unsigned_integral K, typename series_templ
 series_acceleration<T, K, series_templ>::series_acceleration(const series_templ& series) : series(series) {}
 
 template <std::floating_point T, std::unsigned_integral K, typename series_templ>
-constexpr void series_acceleration<T, K, series_templ>::print_info() const
+constexpr void series_acceleration<T, K, series_templ>::print_info(std::ostream& out) const
 {
-	std::cout << "transformation: " << typeid(*this).name() << '\n';
+	out << "transformation: " << typeid(*this).name() << '\n';
+}
+
+template <std::floating_point T, std::unsigned_integral K, typename series_templ>
+std::vector<T> series_acceleration<T, K, series_templ>::transform_all(const K n, const K order) const
+{
+	std::vector<T> result(n + 1, std::numeric_limits<T>::quiet_NaN());
+
+	for (K i = 1; i <= n; ++i)
+		try
+		{
+			result[i] = (*this)(i, order);
+		}
+		catch (std::domain_error&) {}
+		catch (std::overflow_error&) {}
+
+	return result;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "workspace.h" // Include the per-thread workspace
 #include <vector>  // Include the vector library
 
  /**
@@ -33,6 +34,15 @@ public:
    * @return The partial sum after the transformation.
    */
 	T operator()(const K n, const K order) const;
+
+	/**
+   * @brief Shanks transformation for non-alternating function of all partial sums up to nth.
+   * The windows of the table used for T_1, ..., T_n overlap, so a single table on [1, n + order - 1] is built for all of them.
+   * @param n The largest number of terms in the partial sum.
+   * @param order The order of transformation.
+   * @return Vector of the partial sums after the transformation, see series_acceleration::transform_all.
+   */
+	std::vector<T> transform_all(const K n, const K order) const;
 };
 
 template <std::floating_point T, std::unsigned_integral K, typename series_templ>
@@ -66,36 +76,40 @@ T shanks_transform<T, K, series_templ>::operator()(const K n, const K order) con
 	const K n_minus_order = n - order;
 	const K n_plus_order = n + order;
 
-	std::vector<T> T_n(n_plus_order, 0);
+	workspace_vector<T> T_n(n_plus_order, 0);
 
 	T a_n, a_n_plus_1, tmp;
 	a_n = this->series->operator()(n_minus_order);
 	a_n_plus_1 = this->series->operator()(n_minus_order + 1);
 	tmp = -a_n_plus_1 * a_n_plus_1;
 
+	SHANKS_COUNT_CELLS(2 * order - 1);
 	for (K i = n_minus_order + 1; i <= n_plus_order - 1; ++i) // if we got to this branch then we know that n >= order - see previous branches  int -> K
 	{
 		a_n = this->series->operator()(i);
 		a_n_plus_1 = this->series->operator()(i + 1);
 		tmp = -a_n_plus_1 * a_n_plus_1;
+		SHANKS_COUNT_DIVISION(std::fma(a_n, a_n, tmp) - std::fma(a_n_plus_1, a_n_plus_1, tmp));
 
 		//formula[6]
 		T_n[i] = std::fma(a_n * a_n_plus_1, (a_n + a_n_plus_1) / (std::fma(a_n, a_n, tmp) - std::fma(a_n_plus_1, a_n_plus_1, tmp)), this->series->S_n(i));
 	}
-	std::vector<T> T_n_plus_1(n + order, 0);
+	workspace_vector<T> T_n_plus_1(n + order, 0);
 	T a, b, c;
 	for (K j = 2; j <= order; ++j) {
+		SHANKS_COUNT_CELLS(2 * (order - j) + 1);
 		for (K i = n_minus_order + j; i <= n_plus_order - j; ++i) { // int -> K
 			a = T_n[i];
 			b = T_n[i - 1];
 			c = T_n[i + 1];
+			SHANKS_COUNT_DIVISION(std::fma(2, a, -b - c));
 			/*if (!std::isfinite(abs(2 * T_n[i] - T_n[i - 1] - T_n[i + 1])))
 				throw std::overflow_error("division by zero");*/
 				/*T_n_plus_1[i] = T_n[i] - (T_n[i] - T_n[i - 1]) * (T_n[i + 1] - T_n[i]) / (T_n[i + 1] - 2 * T_n[i] + T_n[i - 1]);
 				T_n_plus_1[i] = std::fma(std::fma(T_n[i], T_n[i+1] + T_n[i-1] - T_n[i], -T_n[i-1]*T_n[i+1]), 1 / (2 * T_n[i] - T_n[i - 1] - T_n[i+1]), T_n[i]);*/
 			T_n_plus_1[i] = static_cast<T>(std::fma(std::fma(a, c + b - a, -b * c), 1 / (std::fma(2, a, -b - c)), a));
 		}
-		T_n = T_n_plus_1;
+		std::swap(T_n, T_n_plus_1);
 	}
 	if (!std::isfinite(T_n[n]))
 		throw std::overflow_error("division by zero");
@@ -103,6 +117,59 @@ T shanks_transform<T, K, series_templ>::operator()(const K n, const K order) con
 	return T_n[n];
 }
 
+template <std::floating_point T, std::unsigned_integral K, typename series_templ>
+std::vector<T> shanks_transform<T, K, series_templ>::transform_all(const K n, const K order) const
+{
+	std::vector<T> result(n + 1, std::numeric_limits<T>::quiet_NaN());
+
+	if (order == 0) [[unlikely]] /*it is convenient to assume that transformation of order 0 is no transformation at all*/
+	{
+		for (K i = 1; i <= n; ++i)
+			result[i] = this->series->S_n(i);
+		return result;
+	}
+
+	for (K i = 1; i < order && i <= n; ++i)
+		result[i] = DEF_UNDEFINED_SUM;
+
+	if (n < order) [[unlikely]]
+		return result;
+
+	// T_i uses the jth level of the table on [i - order + j, i + order - j], the same values as operator() computes
+	const K last = n + order - 1;
+
+	workspace_vector<T> T_n(last + 2, 0);
+	workspace_vector<T> T_n_plus_1(last + 2, 0);
+
+	T a_n, a_n_plus_1, tmp;
+	for (K i = 1; i <= last; ++i)
+	{
+		a_n = this->series->operator()(i);
+		a_n_plus_1 = this->series->operator()(i + 1);
+		tmp = -a_n_plus_1 * a_n_plus_1;
+
+		//formula[6]
+		T_n[i] = std::fma(a_n * a_n_plus_1, (a_n + a_n_plus_1) / (std::fma(a_n, a_n, tmp) - std::fma(a_n_plus_1, a_n_plus_1, tmp)), this->series->S_n(i));
+	}
+
+	T a, b, c;
+	for (K j = 2; j <= order; ++j) {
+		for (K i = j; i <= last + 1 - j; ++i) {
+			a = T_n[i];
+			b = T_n[i - 1];
+			c = T_n[i + 1];
+			T_n_plus_1[i] = static_cast<T>(std::fma(std::fma(a, c + b - a, -b * c), 1 / (std::fma(2, a, -b - c)), a));
+		}
+		std::swap(T_n, T_n_plus_1);
+	}
+
+	for (K i = order; i <= n; ++i)
+		if (std::isfinite(T_n[i]))
+			result[i] = T_n[i];
+
+	return result;
+}
+
 /**
 * @brief Shanks transformation for alternating series class.
 * @tparam T The type of the elements in the series, K The type of enumerating integer, series_templ is the type of series whose convergence we accelerate
@@ -158,33 +225,37 @@ T shanks_transform_alternating<T, K, series_templ>::operator()(const K n, const
 	const K n_minus_order1 = n_minus_order + 1;
 	const K n_plus_order = n + order;
 
-	std::vector<T> T_n(n_plus_order, 0);
+	workspace_vector<T> T_n(n_plus_order, 0);
 
 	T a_n, a_n_plus_1;
 	a_n = this->series->operator()(n_minus_order);
 	a_n_plus_1 = this->series->operator()(n_minus_order1);
+	SHANKS_COUNT_CELLS(2 * order - 1);
 	for (K i = n_minus_order1; i <= n_plus_order - 1; ++i) // if we got to this branch then we know that n >= order - see previous branches int->K
 	{
 		a_n = this->series->operator()(i);
 		a_n_plus_1 = this->series->operator()(i + 1);
+		SHANKS_COUNT_DIVISION(a_n - a_n_plus_1);
 
 		// formula [6]
 		T_n[i] = std::fma(a_n * a_n_plus_1, 1 / (a_n - a_n_plus_1), this->series->S_n(n));
 	}
-	std::vector<T> T_n_plus_1(n_plus_order, 0);
+	workspace_vector<T> T_n_plus_1(n_plus_order, 0);
 	T a, b, c;
 	for (K j = 2; j <= order; ++j) {
+		SHANKS_COUNT_CELLS(2 * (order - j) + 1);
 		for (K i = n_minus_order + j; i <= n_plus_order - j; ++i) { // int -> K
 			a = T_n[i];
 			b = T_n[i - 1];
 			c = T_n[i + 1];
+			SHANKS_COUNT_DIVISION(std::fma(2, a, -b - c));
 			/*if (!std::isfinite(abs(2 * T_n[i] - T_n[i - 1] - T_n[i + 1])))
 				throw std::overflow_error("division by zero");*/
 				/*T_n_plus_1[i] = T_n[i] - (T_n[i] - T_n[i - 1]) * (T_n[i + 1] - T_n[i]) / (T_n[i + 1] - 2 * T_n[i] + T_n[i - 1]);
 				T_n_plus_1[i] = std::fma(std::fma(T_n[i], T_n[i+1] + T_n[i-1] - T_n[i], -T_n[i-1]*T_n[i+1]), 1 / (2 * T_n[i] - T_n[i - 1] - T_n[i+1]), T_n[i]);*/
 			T_n_plus_1[i] = std::fma(std::fma(a, c + b - a, -b * c), 1 / (2 * a - b - c), a);
 		}
-		T_n = T_n_plus_1;
+		std::swap(T_n, T_n_plus_1);
 	}
 	if (!isfinite(T_n[n]))
 		throw std::overflow_error("division by zero");
@@ -0,0 +1,102 @@
+/**
+ * @file simd_dispatch.h
+ * @brief This file contains the choice of the instruction set the row kernels run with
+ * The binary contains the kernels of every instruction set. The widest one the CPU supports is chosen at the first
+ * call and kept for the whole run. The environment variable SHANKS_SIMD = scalar, sse4.2, avx2 or avx512 forces
+ * a narrower one, e.g. to compare them in benchmarks; an instruction set the CPU does not support is never chosen.
+ */
+
+#pragma once
+
+#include "simd_pack.h" // Include the vector register wrapper
+#include <cstdlib>     // Include the cstdlib library for std::getenv
+#include <cstring>     // Include the cstring library for std::strcmp
+
+#if defined(_MSC_VER) && defined(SHANKS_SIMD_X86)
+#include <intrin.h> // Include the MSVC intrinsics for __cpuidex and _xgetbv
+#endif
+
+/**
+ * @brief The widest instruction set supported by the CPU and the operating system
+ * @return The instruction set
+ */
+inline simd_isa_t simd_supported_isa()
+{
+#if defined(SHANKS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return simd_avx512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return simd_avx2;
+	if (__builtin_cpu_supports("sse4.2"))
+		return simd_sse42;
+	return simd_scalar;
+#elif defined(SHANKS_SIMD_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuidex(info, 1, 0);
+	const bool sse42 = (info[2] >> 20) & 1;
+	const bool fma = (info[2] >> 12) & 1;
+	const bool osxsave = (info[2] >> 27) & 1;
+
+	const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+	const bool ymm_state = (xcr0 & 0x6) == 0x6; // the operating system saves the SSE and AVX registers
+	const bool zmm_state = (xcr0 & 0xE6) == 0xE6; // and the AVX-512 ones
+
+	__cpuidex(info, 7, 0);
+	const bool avx2 = (info[1] >> 5) & 1;
+	const bool avx512f = (info[1] >> 16) & 1;
+
+	if (avx512f && avx2 && fma && zmm_state)
+		return simd_avx512;
+	if (avx2 && fma && ymm_state)
+		return simd_avx2;
+	if (sse42)
+		return simd_sse42;
+	return simd_scalar;
+#else
+	return simd_scalar;
+#endif
+}
+
+/**
+ * @brief Name of the instruction set, as it is given in SHANKS_SIMD
+ * @param isa The instruction set
+ * @return The name
+ */
+inline const char* simd_isa_name(const simd_isa_t isa)
+{
+	switch (isa) {
+	case simd_sse42:
+		return "sse4.2";
+	case simd_avx2:
+		return "avx2";
+	case simd_avx512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}
+
+/**
+ * @brief The instruction set the row kernels run with, chosen at the first call
+ * It is the widest supported one or, if SHANKS_SIMD names a narrower one, that one. An unknown name is ignored.
+ * @return The instruction set
+ */
+inline simd_isa_t simd_selected_isa()
+{
+	static const simd_isa_t selected = [] {
+		const simd_isa_t supported = simd_supported_isa();
+
+		const char* forced = std::getenv("SHANKS_SIMD");
+		if (forced == nullptr)
+			return supported;
+
+		for (const simd_isa_t isa : { simd_scalar, simd_sse42, simd_avx2, simd_avx512 })
+			if (std::strcmp(forced, simd_isa_name(isa)) == 0)
+				return isa < supported ? isa : supported;
+
+		return supported;
+	}();
+
+	return selected;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file simd_pack.h
+ * @brief This file contains the portable wrapper over the vector registers used by the row kernels
+ * A simd_pack<T, isa> holds width elements of type T and provides the element-wise operations the kernels need.
+ * The packs exist for float and double on x86-64, for any other type (e.g. long double) or target the width is 1
+ * and the kernels run their scalar loops. Which instruction set is used at run time is chosen by simd_dispatch.h.
+ */
+
+#pragma once
+
+#include <concepts> // Include the concepts library for std::floating_point
+#include <cstddef>  // Include the cstddef library for std::size_t
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h> // Include the x86 intrinsics
+#define SHANKS_SIMD_X86
+#endif
+
+// The packs of every instruction set are compiled into the same binary: their functions are marked with the target
+// instruction set, so the compiler emits its instructions there whatever the flags of the translation unit are.
+// MSVC emits the instructions of any intrinsic without it.
+#if defined(__GNUC__) || defined(__clang__)
+#define SHANKS_TARGET(isa) __attribute__((target(isa)))
+#define SHANKS_SIMD_INLINE __attribute__((always_inline)) inline
+#else
+#define SHANKS_TARGET(isa)
+#define SHANKS_SIMD_INLINE __forceinline
+#endif
+
+#define SHANKS_TARGET_SSE42 SHANKS_TARGET("sse4.2")
+#define SHANKS_TARGET_AVX2 SHANKS_TARGET("avx2,fma")
+#define SHANKS_TARGET_AVX512 SHANKS_TARGET("avx512f,avx2,fma")
+
+/**
+ * @brief Enum of the instruction sets of the packs, from the narrowest to the widest
+ */
+enum simd_isa_t {
+	simd_scalar,
+	simd_sse42,
+	simd_avx2,
+	simd_avx512
+};
+
+/**
+ * @brief Pack of width elements of type T in a vector register of the instruction set isa
+ * The primary template is the scalar fallback: its width is 1 and it has no operations, the kernels do not use it.
+ * The specializations provide broadcast, load, store, sequence, +, -, *, /, all_finite and, if has_fma, the fused
+ * fma(a, b, c) = a * b + c, fms(a, b, c) = a * b - c and fnma(a, b, c) = c - a * b, each rounded once like std::fma.
+ * Loads and stores are unaligned, the kernels read the rows at every offset.
+ * @tparam T The type of the elements, isa The instruction set
+ */
+template <std::floating_point T, simd_isa_t isa>
+struct simd_pack
+{
+	static constexpr std::size_t width = 1;
+	static constexpr bool has_fma = false;
+};
+
+#if defined(SHANKS_SIMD_X86)
+
+template <>
+struct simd_pack<double, simd_sse42>
+{
+	static constexpr std::size_t width = 2;
+	static constexpr bool has_fma = false;
+
+	__m128d value;
+
+	SHANKS_TARGET_SSE42 static simd_pack broadcast(const double x) { return { _mm_set1_pd(x) }; }
+	SHANKS_TARGET_SSE42 static simd_pack load(const double* p) { return { _mm_loadu_pd(p) }; }
+	SHANKS_TARGET_SSE42 static simd_pack sequence(const double first) { return { _mm_setr_pd(first, first + 1) }; }
+	SHANKS_TARGET_SSE42 void store(double* p) const { _mm_storeu_pd(p, value); }
+
+	friend SHANKS_TARGET_SSE42 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm_add_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm_sub_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm_mul_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm_div_pd(a.value, b.value) }; }
+
+	friend SHANKS_TARGET_SSE42 bool all_finite(const simd_pack a) {
+		const __m128d zero = _mm_sub_pd(a.value, a.value); // x - x is NaN only for an infinite or NaN x
+		return _mm_movemask_pd(_mm_cmpord_pd(zero, zero)) == 0x3;
+	}
+};
+
+template <>
+struct simd_pack<float, simd_sse42>
+{
+	static constexpr std::size_t width = 4;
+	static constexpr bool has_fma = false;
+
+	__m128 value;
+
+	SHANKS_TARGET_SSE42 static simd_pack broadcast(const float x) { return { _mm_set1_ps(x) }; }
+	SHANKS_TARGET_SSE42 static simd_pack load(const float* p) { return { _mm_loadu_ps(p) }; }
+	SHANKS_TARGET_SSE42 static simd_pack sequence(const float first) { return { _mm_setr_ps(first, first + 1, first + 2, first + 3) }; }
+	SHANKS_TARGET_SSE42 void store(float* p) const { _mm_storeu_ps(p, value); }
+
+	friend SHANKS_TARGET_SSE42 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm_add_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm_sub_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm_mul_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_SSE42 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm_div_ps(a.value, b.value) }; }
+
+	friend SHANKS_TARGET_SSE42 bool all_finite(const simd_pack a) {
+		const __m128 zero = _mm_sub_ps(a.value, a.value);
+		return _mm_movemask_ps(_mm_cmpord_ps(zero, zero)) == 0xF;
+	}
+};
+
+template <>
+struct simd_pack<double, simd_avx2>
+{
+	static constexpr std::size_t width = 4;
+	static constexpr bool has_fma = true;
+
+	__m256d value;
+
+	SHANKS_TARGET_AVX2 static simd_pack broadcast(const double x) { return { _mm256_set1_pd(x) }; }
+	SHANKS_TARGET_AVX2 static simd_pack load(const double* p) { return { _mm256_loadu_pd(p) }; }
+	SHANKS_TARGET_AVX2 static simd_pack sequence(const double first) { return { _mm256_setr_pd(first, first + 1, first + 2, first + 3) }; }
+	SHANKS_TARGET_AVX2 void store(double* p) const { _mm256_storeu_pd(p, value); }
+
+	friend SHANKS_TARGET_AVX2 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm256_add_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm256_sub_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm256_mul_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm256_div_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fmadd_pd(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fms(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fmsub_pd(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fnma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fnmadd_pd(a.value, b.value, c.value) }; }
+
+	friend SHANKS_TARGET_AVX2 bool all_finite(const simd_pack a) {
+		const __m256d zero = _mm256_sub_pd(a.value, a.value);
+		return _mm256_movemask_pd(_mm256_cmp_pd(zero, zero, _CMP_ORD_Q)) == 0xF;
+	}
+};
+
+template <>
+struct simd_pack<float, simd_avx2>
+{
+	static constexpr std::size_t width = 8;
+	static constexpr bool has_fma = true;
+
+	__m256 value;
+
+	SHANKS_TARGET_AVX2 static simd_pack broadcast(const float x) { return { _mm256_set1_ps(x) }; }
+	SHANKS_TARGET_AVX2 static simd_pack load(const float* p) { return { _mm256_loadu_ps(p) }; }
+	SHANKS_TARGET_AVX2 static simd_pack sequence(const float first) { return { _mm256_add_ps(_mm256_set1_ps(first), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7)) }; }
+	SHANKS_TARGET_AVX2 void store(float* p) const { _mm256_storeu_ps(p, value); }
+
+	friend SHANKS_TARGET_AVX2 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm256_add_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm256_sub_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm256_mul_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm256_div_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fmadd_ps(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fms(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fmsub_ps(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX2 simd_pack fnma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm256_fnmadd_ps(a.value, b.value, c.value) }; }
+
+	friend SHANKS_TARGET_AVX2 bool all_finite(const simd_pack a) {
+		const __m256 zero = _mm256_sub_ps(a.value, a.value);
+		return _mm256_movemask_ps(_mm256_cmp_ps(zero, zero, _CMP_ORD_Q)) == 0xFF;
+	}
+};
+
+template <>
+struct simd_pack<double, simd_avx512>
+{
+	static constexpr std::size_t width = 8;
+	static constexpr bool has_fma = true;
+
+	__m512d value;
+
+	SHANKS_TARGET_AVX512 static simd_pack broadcast(const double x) { return { _mm512_set1_pd(x) }; }
+	SHANKS_TARGET_AVX512 static simd_pack load(const double* p) { return { _mm512_loadu_pd(p) }; }
+	SHANKS_TARGET_AVX512 static simd_pack sequence(const double first) { return { _mm512_add_pd(_mm512_set1_pd(first), _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7)) }; }
+	SHANKS_TARGET_AVX512 void store(double* p) const { _mm512_storeu_pd(p, value); }
+
+	friend SHANKS_TARGET_AVX512 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm512_add_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm512_sub_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm512_mul_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm512_div_pd(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fmadd_pd(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fms(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fmsub_pd(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fnma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fnmadd_pd(a.value, b.value, c.value) }; }
+
+	friend SHANKS_TARGET_AVX512 bool all_finite(const simd_pack a) {
+		const __m512d zero = _mm512_sub_pd(a.value, a.value);
+		return _mm512_cmp_pd_mask(zero, zero, _CMP_ORD_Q) == 0xFF;
+	}
+};
+
+template <>
+struct simd_pack<float, simd_avx512>
+{
+	static constexpr std::size_t width = 16;
+	static constexpr bool has_fma = true;
+
+	__m512 value;
+
+	SHANKS_TARGET_AVX512 static simd_pack broadcast(const float x) { return { _mm512_set1_ps(x) }; }
+	SHANKS_TARGET_AVX512 static simd_pack load(const float* p) { return { _mm512_loadu_ps(p) }; }
+	SHANKS_TARGET_AVX512 static simd_pack sequence(const float first) { return { _mm512_add_ps(_mm512_set1_ps(first), _mm512_setr_ps(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)) }; }
+	SHANKS_TARGET_AVX512 void store(float* p) const { _mm512_storeu_ps(p, value); }
+
+	friend SHANKS_TARGET_AVX512 simd_pack operator+(const simd_pack a, const simd_pack b) { return { _mm512_add_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator-(const simd_pack a, const simd_pack b) { return { _mm512_sub_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator*(const simd_pack a, const simd_pack b) { return { _mm512_mul_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack operator/(const simd_pack a, const simd_pack b) { return { _mm512_div_ps(a.value, b.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fmadd_ps(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fms(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fmsub_ps(a.value, b.value, c.value) }; }
+	friend SHANKS_TARGET_AVX512 simd_pack fnma(const simd_pack a, const simd_pack b, const simd_pack c) { return { _mm512_fnmadd_ps(a.value, b.value, c.value) }; }
+
+	friend SHANKS_TARGET_AVX512 bool all_finite(const simd_pack a) {
+		const __m512 zero = _mm512_sub_ps(a.value, a.value);
+		return _mm512_cmp_ps_mask(zero, zero, _CMP_ORD_Q) == 0xFFFF;
+	}
+};
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file span_series.h
+ * @brief This file contains the series adapter over a caller-supplied sequence, which lets every transformation run directly on external data
+ */
+
+#pragma once
+
+#include <span>      // Include the span library for std::span
+#include <stdexcept> // Include the stdexcept library for std::domain_error
+#include "series.h"
+
+/**
+ * @brief Enum of the kinds of values that can be given to span_series
+ */
+enum sequence_kind_t {
+	partial_sums_sequence,
+	terms_sequence
+};
+
+/**
+ * @brief Series over a caller-supplied sequence of partial sums or terms
+ * The values are not copied: the series reads them straight from the given memory, so it must outlive the series.
+ * The class is final, so when a transformation is instantiated with series_templ = span_series<T, K>*,
+ * the calls of operator() and S_n are resolved statically, without a virtual call per element. For example:
+ * @code
+ * span_series<double, unsigned> sums(std::span<const double>(buffer), partial_sums_sequence);
+ * epsilon_algorithm<double, unsigned, span_series<double, unsigned>*> transform(&sums);
+ * const double result = transform(n, order);
+ * @endcode
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class span_series final : public series_base<T, K>
+{
+public:
+	span_series() = delete;
+
+	/**
+	* @brief Parameterized constructor to initialize the series with the sequence
+	* @param values The partial sums S_0, S_1, ... or the terms a_0, a_1, ... of the series
+	* @param kind What the values are: partial sums or terms
+	* @param sum The sum of the series if it is known, 0 by default
+	*/
+	span_series(std::span<const T> values, sequence_kind_t kind = partial_sums_sequence, T sum = 0);
+
+	/**
+	* @brief Computes nth term of the series
+	* For a sequence of partial sums it is the difference of two neighbouring partial sums
+	* @param n The number of the term
+	* @return nth term of the series
+	*/
+	[[nodiscard]] constexpr virtual T operator()(K n) const final;
+
+	/**
+	* @brief Computes partial sum of the first n terms
+	* For a sequence of partial sums it is read directly, for a sequence of terms the memoized sum of series_base is used
+	* @param n The amount of terms in the partial sum
+	* @return Partial sum of the first n terms
+	*/
+	[[nodiscard]] constexpr T S_n(K n) const;
+
+	/**
+	* @brief Amount of values in the given sequence
+	* @return The amount of partial sums or terms that can be accessed
+	*/
+	[[nodiscard]] constexpr K size() const;
+
+private:
+	/**
+	* @brief Reads nth value of the sequence
+	* @param n The number of the value
+	* @return nth value
+	*/
+	[[nodiscard]] constexpr T at(K n) const;
+
+	/**
+	* @brief The caller-supplied sequence
+	*/
+	const std::span<const T> values;
+
+	/**
+	* @brief What the values of the sequence are
+	*/
+	const sequence_kind_t kind;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+span_series<T, K>::span_series(std::span<const T> values, sequence_kind_t kind, T sum) : series_base<T, K>(0, sum), values(values), kind(kind)
+{
+	if (values.empty())
+		throw std::domain_error("empty sequence input");
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr T span_series<T, K>::at(K n) const
+{
+	if (n >= values.size())
+		throw std::domain_error("the transformation needs more values than the sequence has");
+
+	return values[n];
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr T span_series<T, K>::operator()(K n) const
+{
+	if (kind == terms_sequence)
+		return at(n);
+
+	return n == 0 ? at(0) : at(n) - values[n - 1];
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr T span_series<T, K>::S_n(K n) const
+{
+	if (kind == partial_sums_sequence)
+		return at(n);
+
+	return series_base<T, K>::S_n(n);
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr K span_series<T, K>::size() const
+{
+	return static_cast<K>(values.size());
+}
@@ -0,0 +1,413 @@
+/**
+ * @file streaming_acceleration.h
+ * @brief This file contains the streaming transformations, which are given the terms of the series one by one
+ * Every series_acceleration subclass computes the transformed partial sum for given n and order from scratch.
+ * A streaming transformation instead keeps the newest anti-diagonal of its table, so a new term costs O(order)
+ * and the transformed partial sum of all terms pushed so far is always at hand.
+ */
+
+#pragma once
+#define DEF_UNDEFINED_SUM 0
+
+#include "series_acceleration.h" // Include the series header
+#include "remainders.h" // Include the remainders for the Drummond's D-transformation
+#include <memory> // For std::unique_ptr
+#include <vector> // Include the vector library
+
+/**
+ * @brief Base class for the streaming transformations
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class streaming_acceleration
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the streaming transformation
+	* @param order The order of the transformation
+	*/
+	streaming_acceleration(const K order);
+
+	virtual ~streaming_acceleration() = default;
+
+	/**
+	* @brief Gives the next term a_n of the series to the transformation, the first pushed term is a_0
+	* @param term The next term of the series
+	*/
+	void push(const T term);
+
+	/**
+	* @brief The partial sum after the transformation of all terms pushed so far
+	* While there are not enough terms for the given order, the transformation of the highest order available is returned
+	* @return The partial sum after the transformation
+	*/
+	virtual T estimate() const = 0;
+
+	/**
+	* @brief Amount of pushed terms
+	* @return The amount of terms pushed so far
+	*/
+	[[nodiscard]] constexpr K size() const;
+
+	/**
+	* @brief Partial sum of the pushed terms
+	* @return The sum of all terms pushed so far
+	*/
+	[[nodiscard]] constexpr T partial_sum() const;
+
+	/**
+	* @brief Method for printing out the info about the object of this class
+	*/
+	constexpr void print_info() const;
+
+protected:
+	/**
+	* @brief Updates the table with the newest term, the partial sum already includes it and size() does not yet
+	* @param term The newest term of the series
+	*/
+	virtual void update(const T term) = 0;
+
+	/**
+	* @brief Order of the transformation
+	*/
+	const K order;
+
+private:
+	/**
+	* @brief Amount of pushed terms
+	*/
+	K terms_count;
+
+	/**
+	* @brief Sum of pushed terms
+	*/
+	T sum;
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+streaming_acceleration<T, K>::streaming_acceleration(const K order) : order(order), terms_count(0), sum(0) {}
+
+template <std::floating_point T, std::unsigned_integral K>
+void streaming_acceleration<T, K>::push(const T term)
+{
+	sum += term;
+	update(term);
+	++terms_count;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr K streaming_acceleration<T, K>::size() const
+{
+	return terms_count;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr T streaming_acceleration<T, K>::partial_sum() const
+{
+	return sum;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+constexpr void streaming_acceleration<T, K>::print_info() const
+{
+	std::cout << "streaming transformation: " << typeid(*this).name() << '\n';
+}
+
+/**
+ * @brief Streaming Wynn epsilon algorithm
+ * Keeps eps_k^(m-k) for k = 0, ..., 2 * order, where S_m is the newest partial sum.
+ * The new partial sum starts a new anti-diagonal: eps_k^(m-k) = eps_(k-2)^(m-k+1) + 1 / (eps_(k-1)^(m-k+1) - eps_(k-1)^(m-k)).
+ * The estimate is eps_(2 * order)^(m - 2 * order), the value epsilon_algorithm gives from the same partial sums.
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class streaming_epsilon_algorithm : public streaming_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the streaming Epsilon Algorithm
+	* @param order The order of the transformation
+	*/
+	streaming_epsilon_algorithm(const K order) : streaming_acceleration<T, K>(order) {}
+
+	/**
+	* @brief The partial sum after the transformation of all terms pushed so far
+	* @return The newest element of the column 2 * order or of the highest even column available
+	*/
+	T estimate() const {
+		if (diagonal.empty())
+			return DEF_UNDEFINED_SUM;
+
+		const T result = diagonal[(diagonal.size() - 1) & ~std::size_t(1)];
+
+		if (!std::isfinite(result))
+			throw std::overflow_error("division by zero");
+
+		return result;
+	}
+
+protected:
+	void update(const T term) {
+		if (diagonal.size() < std::size_t(2) * this->order + 1)
+			diagonal.push_back(0);
+
+		T lower = T(0); // eps_(-1) is zero
+		T old = diagonal[0];
+		diagonal[0] = this->partial_sum();
+
+		for (std::size_t k = 1; k < diagonal.size(); ++k) {
+			const T next_old = diagonal[k];
+			diagonal[k] = lower + T(1) / (diagonal[k - 1] - old);
+			lower = old;
+			old = next_old;
+		}
+	}
+
+private:
+	/**
+	* @brief The newest anti-diagonal of the epsilon table
+	*/
+	std::vector<T> diagonal;
+};
+
+/**
+ * @brief Streaming Shanks transformation
+ * Keeps the two newest elements of every level of the iterated Aitken table used by shanks_transform.
+ * The term a_m adds the element m - 1 of the first level, which adds one element to every next level that already has two.
+ * The estimate is the newest element of the level order, the value shanks_transform gives from the same terms.
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class streaming_shanks_transform : public streaming_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the streaming Shanks transformation
+	* @param order The order of the transformation
+	*/
+	streaming_shanks_transform(const K order) : streaming_acceleration<T, K>(order), previous_term(0), previous_sum(0) {}
+
+	/**
+	* @brief The partial sum after the transformation of all terms pushed so far
+	* @return The newest element of the level order or of the highest level available
+	*/
+	T estimate() const {
+		if (levels.empty())
+			return this->partial_sum();
+
+		const T result = levels.back().latest;
+
+		if (!std::isfinite(result))
+			throw std::overflow_error("division by zero");
+
+		return result;
+	}
+
+protected:
+	void update(const T term) {
+		if (this->size() != 0 && this->order != 0) {
+			const T tmp = -term * term;
+
+			//formula[6]
+			T value = std::fma(previous_term * term, (previous_term + term) / (std::fma(previous_term, previous_term, tmp) - std::fma(term, term, tmp)), previous_sum);
+
+			for (K j = 0; j < this->order; ++j) {
+				if (j == levels.size())
+					levels.push_back({ 0, 0, 0 });
+
+				level& current = levels[j];
+				const T a = current.latest;
+				const T b = current.previous;
+				const T c = value;
+
+				current.previous = a;
+				current.latest = c;
+				++current.count;
+
+				if (current.count < 3)
+					break;
+
+				value = static_cast<T>(std::fma(std::fma(a, c + b - a, -b * c), 1 / (std::fma(2, a, -b - c)), a));
+			}
+		}
+
+		previous_term = term;
+		previous_sum = this->partial_sum();
+	}
+
+private:
+	/**
+	* @brief The two newest elements of a level of the table
+	*/
+	struct level {
+		T previous;
+		T latest;
+		K count;
+	};
+
+	std::vector<level> levels;
+	T previous_term;
+	T previous_sum;
+};
+
+/**
+ * @brief Streaming Richardson transformation
+ * Keeps the newest row e_l[m], l = 0, ..., min(m, order), of the Richardson table, where S_m is the newest partial sum:
+ * e_l[m] = (4^l * e_(l-1)[m] - e_(l-1)[m-1]) / (4^l - 1).
+ * richardson_algorithm uses all n levels, here the levels are limited by the order so a new term costs O(order).
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class streaming_richardson_algorithm : public streaming_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the streaming Richardson transformation
+	* @param order The largest level of the table
+	*/
+	streaming_richardson_algorithm(const K order) : streaming_acceleration<T, K>(order) {}
+
+	/**
+	* @brief The partial sum after the transformation of all terms pushed so far
+	* @return The element of the highest level in the newest row
+	*/
+	T estimate() const {
+		if (row.empty())
+			return DEF_UNDEFINED_SUM;
+
+		const T result = row.back();
+
+		if (!std::isfinite(result))
+			throw std::overflow_error("division by zero");
+
+		return result;
+	}
+
+protected:
+	void update(const T term) {
+		if (row.size() <= this->order)
+			row.push_back(0);
+
+		T old = row[0];
+		row[0] = this->partial_sum();
+
+		T a = static_cast<T>(1);
+		for (std::size_t l = 1; l < row.size(); ++l) {
+			a *= 4;
+			const T next_old = row[l];
+			row[l] = fma(a, row[l - 1], -old) / (a - 1);
+			old = next_old;
+		}
+	}
+
+private:
+	/**
+	* @brief The newest row of the Richardson table
+	*/
+	std::vector<T> row;
+};
+
+/**
+ * @brief Streaming Drummond's D-transformation
+ * Keeps the newest anti-diagonals of the forward difference tables of N_j = S_j * w_j and D_j = w_j,
+ * where w_j is the remainder. The estimate is Δ^order N_(j-order) / Δ^order D_(j-order) for the newest j,
+ * the value drummonds_algorithm with recursive = true gives from the same terms.
+ * Some remainders need the term after a_j, then w_j is taken as soon as it is pushed.
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class streaming_drummonds_algorithm : public streaming_acceleration<T, K>
+{
+public:
+	/**
+	* @brief Parameterized constructor to initialize the streaming Drummond's D-transformation
+	* @param order The order of the transformation
+	* @param func Remainder function
+	*/
+	streaming_drummonds_algorithm(const K order, const transform_base<T, K>* func) : streaming_acceleration<T, K>(order), remainder_func(func), weights_count(0) {
+		if (func == nullptr)
+			throw std::domain_error("null poniter remainder function");
+	}
+
+	/**
+	* @brief The partial sum after the transformation of all terms pushed so far
+	* @return The ratio of the newest differences of the highest order available
+	*/
+	T estimate() const {
+		if (D.empty())
+			return this->partial_sum();
+
+		const T result = N.back() / D.back();
+
+		if (!std::isfinite(result))
+			throw std::overflow_error("division by zero");
+
+		return result;
+	}
+
+protected:
+	void update(const T term) {
+		terms.values.push_back(term);
+		sums.push_back(this->partial_sum());
+
+		while (weights_count < terms.values.size()) {
+			T w_n;
+			try {
+				w_n = remainder_func->operator()(0, static_cast<K>(weights_count), &terms);
+			}
+			catch (std::domain_error&) { // the remainder needs a term which is not pushed yet
+				break;
+			}
+			catch (std::overflow_error&) { // the differences containing this weight are undefined
+				w_n = std::numeric_limits<T>::quiet_NaN();
+			}
+
+			push_difference(N, sums[weights_count] * w_n);
+			push_difference(D, w_n);
+			++weights_count;
+		}
+	}
+
+private:
+	/**
+	* @brief Series of the pushed terms, it is given to the remainder function
+	*/
+	class pushed_terms_series : public series_base<T, K>
+	{
+	public:
+		T operator()(K n) const {
+			if (n >= values.size())
+				throw std::domain_error("the term is not pushed yet");
+
+			return values[n];
+		}
+
+		std::vector<T> values;
+	};
+
+	/**
+	* @brief Adds X_j to the anti-diagonal Δ^k X_(j-k), k = 0, ..., min(j, order)
+	* @param diagonal The anti-diagonal of the difference table
+	* @param value The new element X_j
+	*/
+	void push_difference(std::vector<T>& diagonal, const T value) const {
+		if (diagonal.size() <= this->order)
+			diagonal.push_back(0);
+
+		T old = diagonal[0];
+		diagonal[0] = value;
+
+		for (std::size_t k = 1; k < diagonal.size(); ++k) {
+			const T next_old = diagonal[k];
+			diagonal[k] = diagonal[k - 1] - old;
+			old = next_old;
+		}
+	}
+
+	std::unique_ptr<const transform_base<T, K>> remainder_func;
+	pushed_terms_series terms;
+	std::vector<T> sums;
+	std::size_t weights_count;
+	std::vector<T> N;
+	std::vector<T> D;
+};
@@ -0,0 +1,227 @@
+/**
+ * @file term_store.h
+ * @brief This file contains the concurrent append-only storage used for terms and partial sums of series
+ */
+
+#pragma once
+
+#include <array>     // Include the array library for the segment table
+#include <atomic>    // Include the atomic library for lock-free publication of new elements
+#include <bit>       // Include the bit library for std::bit_width
+#include <concepts>  // Include the concepts library for std::floating_point
+#include <memory>    // Include the memory library for std::unique_ptr
+#include <mutex>     // Include the mutex library for serializing writers
+#include <stdexcept> // Include the stdexcept library for std::domain_error
+#include <vector>    // Include the vector library
+
+/**
+ * @brief Concurrent append-only store of the first elements of a sequence
+ * The elements live in segments of doubling size which are never reallocated, so a published element never moves.
+ * Readers of already published elements never block: they only do an acquire load of the published length.
+ * A single writer at a time extends the sequence under a mutex and publishes every new element with a release store.
+ * @tparam T The type of the elements in the sequence
+ */
+template <std::floating_point T>
+class concurrent_term_store
+{
+public:
+	using size_type = std::size_t;
+
+	/**
+	* @brief Default constructor, creates an empty store
+	*/
+	concurrent_term_store();
+
+	/**
+	* @brief Parameterized constructor to initialize the store with the first elements of the sequence
+	* @param first_elements The first elements of the sequence
+	*/
+	concurrent_term_store(const std::vector<T>& first_elements);
+
+	/**
+	* @brief Copy constructor, copies the elements published in the other store
+	* @param other The store to copy
+	*/
+	concurrent_term_store(const concurrent_term_store& other);
+
+	concurrent_term_store& operator=(const concurrent_term_store&) = delete;
+
+	~concurrent_term_store();
+
+	/**
+	* @brief Amount of published elements
+	* @return The amount of elements that can be read without extending the store
+	*/
+	[[nodiscard]] size_type size() const;
+
+	/**
+	* @brief Reads nth published element, n must be less than size()
+	* @param n The number of the element
+	* @return nth element
+	*/
+	[[nodiscard]] T operator[](size_type n) const;
+
+	/**
+	* @brief Returns nth element, extending the store up to it if needed
+	* Safe to call from several threads: if nth element is already published it is read without locking,
+	* otherwise the calling thread becomes the writer and computes the missing elements one by one
+	* @param n The number of the element
+	* @param next Functor next(i, previous) that computes ith element from (i-1)th one, previous is T(0) for the first element of an empty store
+	* @return nth element
+	*/
+	template <typename Generator>
+	T extend_to(size_type n, Generator&& next) const;
+
+	/**
+	* @brief Drops the elements starting from nth one and releases the segments which are no longer used
+	* Must not be called concurrently with any other member function
+	* @param n The amount of elements to keep
+	*/
+	void truncate(size_type n);
+
+	/**
+	* @brief Drops all elements
+	* Must not be called concurrently with any other member function
+	*/
+	void clear();
+
+private:
+	/**
+	* @brief Amount of elements in the first segment, every next segment is twice as big as the previous one
+	*/
+	static constexpr size_type first_segment_size = 64;
+
+	/**
+	* @brief Maximum amount of segments, enough for any size_type index
+	*/
+	static constexpr size_type max_segments = 48;
+
+	/**
+	* @brief Number of the segment containing nth element
+	*/
+	[[nodiscard]] static constexpr size_type segment_of(size_type n);
+
+	/**
+	* @brief Index of the first element of the segment
+	*/
+	[[nodiscard]] static constexpr size_type segment_begin(size_type segment);
+
+	/**
+	* @brief Writes nth element allocating its segment if needed, is called only by the writer
+	*/
+	void store(size_type n, T value) const;
+
+	mutable std::array<std::atomic<T*>, max_segments> segments;
+	mutable std::atomic<size_type> published;
+	mutable std::mutex writer;
+};
+
+template <std::floating_point T>
+concurrent_term_store<T>::concurrent_term_store() : published(0)
+{
+	for (auto& segment : segments)
+		segment.store(nullptr, std::memory_order_relaxed);
+}
+
+template <std::floating_point T>
+concurrent_term_store<T>::concurrent_term_store(const std::vector<T>& first_elements) : concurrent_term_store()
+{
+	for (size_type i = 0; i < first_elements.size(); ++i)
+		store(i, first_elements[i]);
+	published.store(first_elements.size(), std::memory_order_release);
+}
+
+template <std::floating_point T>
+concurrent_term_store<T>::concurrent_term_store(const concurrent_term_store& other) : concurrent_term_store()
+{
+	const size_type size = other.size();
+	for (size_type i = 0; i < size; ++i)
+		store(i, other[i]);
+	published.store(size, std::memory_order_release);
+}
+
+template <std::floating_point T>
+concurrent_term_store<T>::~concurrent_term_store()
+{
+	for (auto& segment : segments)
+		delete[] segment.load(std::memory_order_relaxed);
+}
+
+template <std::floating_point T>
+constexpr typename concurrent_term_store<T>::size_type concurrent_term_store<T>::segment_of(size_type n)
+{
+	return static_cast<size_type>(std::bit_width(n / first_segment_size + 1)) - 1;
+}
+
+template <std::floating_point T>
+constexpr typename concurrent_term_store<T>::size_type concurrent_term_store<T>::segment_begin(size_type segment)
+{
+	return first_segment_size * ((size_type(1) << segment) - 1);
+}
+
+template <std::floating_point T>
+typename concurrent_term_store<T>::size_type concurrent_term_store<T>::size() const
+{
+	return published.load(std::memory_order_acquire);
+}
+
+template <std::floating_point T>
+T concurrent_term_store<T>::operator[](size_type n) const
+{
+	const size_type segment = segment_of(n);
+	return segments[segment].load(std::memory_order_acquire)[n - segment_begin(segment)];
+}
+
+template <std::floating_point T>
+void concurrent_term_store<T>::store(size_type n, T value) const
+{
+	const size_type segment = segment_of(n);
+	if (segment >= max_segments)
+		throw std::domain_error("too many terms requested");
+
+	T* data = segments[segment].load(std::memory_order_relaxed);
+	if (data == nullptr) {
+		data = new T[first_segment_size << segment];
+		segments[segment].store(data, std::memory_order_release);
+	}
+	data[n - segment_begin(segment)] = value;
+}
+
+template <std::floating_point T>
+template <typename Generator>
+T concurrent_term_store<T>::extend_to(size_type n, Generator&& next) const
+{
+	if (n < published.load(std::memory_order_acquire))
+		return (*this)[n];
+
+	std::lock_guard<std::mutex> lock(writer);
+
+	size_type size = published.load(std::memory_order_relaxed); // another writer could have extended the store while we were waiting
+	T previous = size == 0 ? T(0) : (*this)[size - 1];
+
+	for (; size <= n; ++size) {
+		previous = next(size, previous);
+		store(size, previous);
+		published.store(size + 1, std::memory_order_release);
+	}
+
+	return (*this)[n];
+}
+
+template <std::floating_point T>
+void concurrent_term_store<T>::truncate(size_type n)
+{
+	if (n >= published.load(std::memory_order_relaxed))
+		return;
+
+	published.store(n, std::memory_order_release);
+
+	for (size_type segment = (n == 0 ? 0 : segment_of(n - 1) + 1); segment < max_segments; ++segment)
+		delete[] segments[segment].exchange(nullptr, std::memory_order_relaxed);
+}
+
+template <std::floating_point T>
+void concurrent_term_store<T>::clear()
+{
+	truncate(0);
+}
@@ -7,6 +7,8 @@
 #include <memory>
 #include <string> 
 #include <set>
+#include <sstream>
+#include <vector>
 
 #include "wynn_numerators.h"
 #include "remainders.h"
@@ -32,6 +34,8 @@
 #include "epsilon_modified_algorithm.h"
 #include "theta_modified_algorithm.h"
 #include "epsilon_aitken_theta_algorithm.h"
+#include "thread_pool.h"
+#include "counting_series.h"
 
  /**
   * @brief Enum of transformation IDs
@@ -185,7 +189,8 @@ enum test_function_id_t {
 	transformation_remainder_id,
 	cmp_transformations_id,
 	eval_transform_time_id,
-	test_all_transforms_id
+	test_all_transforms_id,
+	check_all_orders_id
 };
 
 /**
@@ -365,7 +370,8 @@ inline static void print_test_function_info()
 		"3 - transformation_remainders - showcases the difference between series' sum and transformed partial sum" << '\n' <<
 		"4 - cmp_transformations - showcases the difference between convergence of sums accelerated by different transformations" << '\n' <<
 		"5 - eval_transform_time - evaluates the time it takes to transform series" << '\n' <<
-		"6 - test all algorithms on summ" << '\n'
+		"6 - test all algorithms on summ" << '\n' <<
+		"7 - check_all_orders - checks the orders 0..order of Lubkin W computed in one table against each order alone" << '\n'
 		<< '\n';
 }
 
@@ -929,6 +935,9 @@ inline static void main_testing_function()
 		throw std::domain_error("wrong series_id");
 	}
 
+	if constexpr (instrumentation_enabled) // count the terms the transformations take
+		series.reset(new counting_series<T, K>(std::move(series)));
+
 	//choosing transformation
 	print_transformation_info();
 	K transformation_id = read_input<K>();
@@ -1199,152 +1208,166 @@ inline static void main_testing_function()
 		}
 		else epsilon_algorithm_3 = T(1e-3);
 
-		for (K i = 1; i <= n; i++)
 		{
-			print_sum(i, std::move(series.get()));
+			std::vector<std::unique_ptr<series_acceleration<T, K, decltype(series.get())>>> transforms;
 
-			//shanks
-			if (alternating_series.contains(series_id))
-				transform.reset(new shanks_transform_alternating<T, K, decltype(series.get())>(series.get()));
-			else
-				transform.reset(new shanks_transform<T, K, decltype(series.get())>(series.get()));
-			
-			print_transform(i, order, std::move(transform.get()));
-
-			//epsilon v-1
-			transform.reset(new epsilon_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//epsilon v-2
-			transform.reset(new epsilon_algorithm_two<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//epsilon v-3
-			transform.reset(new epsilon_algorithm_three<T, K, decltype(series.get())>(series.get(), epsilon_algorithm_3));
-			print_transform(i, order, std::move(transform.get()));
-
-			//rho-wynn
-			transform.reset(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new rho_transform<T, K>{}));
-			print_transform(i, order, std::move(transform.get()));
-
-			//rho-wynn
-			transform.reset(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new generilized_transform<T, K>{}, gamma_rho_Wynn_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-
-			//rho-wynn
-			transform.reset(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new gamma_rho_transform<T, K>{}, gamma_rho_Wynn_algorithm, RHO_rho_Wynn_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-
-			//theta-brezinski
-			transform.reset(new theta_brezinski_algorithm<T, K, decltype(series.get())>(series.get()));
-
-			//chang epsilon wynn
-			transform.reset(new chang_whynn_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//levin standart
-			transform.reset(new levin_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//levin recurcive
-			transform.reset(new levin_recursion_algorithm<T, K, decltype(series.get())>(series.get(), beta_levin_recursion_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-
-			//levin-sidi S U
-			transform.reset(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, false, beta_Levin_S_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi S T
-			transform.reset(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, false, beta_Levin_S_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi S D
-			transform.reset(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, false, beta_Levin_S_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi S V
-			transform.reset(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform<T, K>{}, false, beta_Levin_S_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-
-			//levin-sidi D U
-			transform.reset(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, false));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi D T
-			transform.reset(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, false));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi D D
-			transform.reset(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, false));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi D V
-			transform.reset(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform<T, K>{}, false));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi M U
-			transform.reset(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, gamma_Levin_M_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi M T
-			transform.reset(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, gamma_Levin_M_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi M D
-			transform.reset(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, gamma_Levin_M_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//levin-sidi M V
-			transform.reset(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform_2<T, K>{}, gamma_Levin_M_algorithm));
-			print_transform(i, order, std::move(transform.get()));
-			//
-
-			//weniger
-			transform.reset(new weniger_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//lubkin W
-			transform.reset(new W_lubkin_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//Richardson
-			transform.reset(new richardson_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//Ford-Sidi
-			transform.reset(new ford_sidi_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//Ford-Sidi v-2
-			transform.reset(new ford_sidi_algorithm_two<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//epsilon modified algorithm
-			transform.reset(new epsilon_modified_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//theta modified algorithm
-			transform.reset(new theta_modified_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
-
-			//epsilon aitken theta algorithm algorithm
-			transform.reset(new epsilon_aitken_theta_algorithm<T, K, decltype(series.get())>(series.get()));
-			print_transform(i, order, std::move(transform.get()));
+			{
+				SHANKS_TRACE_SCOPE("transform construction");
 
-			std::cout << '\n';
+				//shanks
+				if (alternating_series.contains(series_id))
+					transforms.emplace_back(new shanks_transform_alternating<T, K, decltype(series.get())>(series.get()));
+				else
+					transforms.emplace_back(new shanks_transform<T, K, decltype(series.get())>(series.get()));
+
+				//epsilon v-1
+				transforms.emplace_back(new epsilon_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//epsilon v-2
+				transforms.emplace_back(new epsilon_algorithm_two<T, K, decltype(series.get())>(series.get()));
+
+				//epsilon v-3
+				transforms.emplace_back(new epsilon_algorithm_three<T, K, decltype(series.get())>(series.get(), epsilon_algorithm_3));
+
+				//rho-wynn
+				transforms.emplace_back(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new rho_transform<T, K>{}));
+
+				//rho-wynn
+				transforms.emplace_back(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new generilized_transform<T, K>{}, gamma_rho_Wynn_algorithm));
+
+				//rho-wynn
+				transforms.emplace_back(new rho_Wynn_algorithm<T, K, decltype(series.get())>(series.get(), new gamma_rho_transform<T, K>{}, gamma_rho_Wynn_algorithm, RHO_rho_Wynn_algorithm));
+
+				//chang epsilon wynn
+				transforms.emplace_back(new chang_whynn_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//levin standart
+				transforms.emplace_back(new levin_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//levin recurcive
+				transforms.emplace_back(new levin_recursion_algorithm<T, K, decltype(series.get())>(series.get(), beta_levin_recursion_algorithm));
+
+				//levin-sidi S U
+				transforms.emplace_back(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, false, beta_Levin_S_algorithm));
+				//
+
+				//levin-sidi S T
+				transforms.emplace_back(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, false, beta_Levin_S_algorithm));
+				//
+
+				//levin-sidi S D
+				transforms.emplace_back(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, false, beta_Levin_S_algorithm));
+				//
+
+				//levin-sidi S V
+				transforms.emplace_back(new levi_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform<T, K>{}, false, beta_Levin_S_algorithm));
+
+				//levin-sidi D U
+				transforms.emplace_back(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, false));
+				//
+
+				//levin-sidi D T
+				transforms.emplace_back(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, false));
+				//
+
+				//levin-sidi D D
+				transforms.emplace_back(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, false));
+				//
+
+				//levin-sidi D V
+				transforms.emplace_back(new drummonds_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform<T, K>{}, false));
+				//
+
+				//levin-sidi M U
+				transforms.emplace_back(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new u_transform<T, K>{}, gamma_Levin_M_algorithm));
+				//
+
+				//levin-sidi M T
+				transforms.emplace_back(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new t_transform<T, K>{}, gamma_Levin_M_algorithm));
+				//
+
+				//levin-sidi M D
+				transforms.emplace_back(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new d_transform<T, K>{}, gamma_Levin_M_algorithm));
+				//
+
+				//levin-sidi M V
+				transforms.emplace_back(new M_levin_sidi_algorithm<T, K, decltype(series.get())>(series.get(), new v_transform_2<T, K>{}, gamma_Levin_M_algorithm));
+				//
+
+				//weniger
+				transforms.emplace_back(new weniger_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//lubkin W
+				transforms.emplace_back(new W_lubkin_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//Richardson
+				transforms.emplace_back(new richardson_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//Ford-Sidi
+				transforms.emplace_back(new ford_sidi_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//Ford-Sidi v-2
+				transforms.emplace_back(new ford_sidi_algorithm_two<T, K, decltype(series.get())>(series.get()));
+
+				//epsilon modified algorithm
+				transforms.emplace_back(new epsilon_modified_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//theta modified algorithm
+				transforms.emplace_back(new theta_modified_algorithm<T, K, decltype(series.get())>(series.get()));
+
+				//epsilon aitken theta algorithm algorithm
+				transforms.emplace_back(new epsilon_aitken_theta_algorithm<T, K, decltype(series.get())>(series.get()));
+			}
+
+			// the task (i - 1) * columns + c prints S_i for c = 0 and T_i of the transformation c - 1 otherwise;
+			// the tasks run on all cores and print to their own cells, which are then printed in the order of the cells
+			const std::size_t columns = transforms.size() + 1;
+			std::vector<std::string> cells(n * columns);
+
+			work_stealing_pool pool;
+			pool.parallel_for(cells.size(), [&](const std::size_t task) {
+				const K i = static_cast<K>(task / columns + 1);
+				const std::size_t c = task % columns;
+
+				std::ostringstream out;
+				out.copyfmt(std::cout);
+				if (c == 0)
+					print_sum(i, std::move(series.get()), out);
+				else
+					print_transform(i, order, std::move(transforms[c - 1].get()), out);
+				cells[task] = out.str();
+			});
+
+			if constexpr (instrumentation_enabled)
+				std::cout << "the series is shared, so a term is counted by the transformation that needs it first" << '\n';
+
+			{
+				SHANKS_TRACE_SCOPE("output");
+				for (std::size_t task = 0; task < cells.size(); ++task) {
+					std::cout << cells[task];
+					if (task % columns == columns - 1)
+						std::cout << '\n';
+				}
+			}
 		}
 
+		if constexpr (tracing_enabled)
+			trace_recorder::instance().write();
+
 		break;
+	case test_function_id_t::check_all_orders_id:
+	{
+		const auto lubkin = dynamic_cast<const W_lubkin_algorithm<T, K, decltype(series.get())>*>(transform.get());
+		if (lubkin == nullptr)
+			throw std::domain_error("all_orders is available only for the Lubkin W transformation");
+
+		K matching = 0;
+		for (K i = 1; i <= n; ++i)
+			if (check_all_orders(i, order, lubkin))
+				++matching;
+		std::cout << "all_orders matches operator() for " << matching << " of " << n << " values of n" << '\n';
+		break;
+	}
 	default:
 		throw std::domain_error("wrong function_id");
 	}
@@ -7,8 +7,89 @@
 #include <exception>
 #include "test_functions.h"
 #include "series_acceleration.h"
+#include "allocation_profiler.h"
 //#include "series.h"
 #include <chrono>
+#include <vector>
+#include <limits>
+#include <string>
+
+/**
+* @brief Function that computes the transformed partial sums of first i terms for all i from 1 to n at once
+* If the transformation fails as a whole, all of the sums are marked as undefined
+* @tparam transform_type is the type of transformation we are using
+* @param n The number of terms
+* @param order The order of the transformation
+* @param test The type of transformation that is being used
+* @return Vector of the transformed partial sums, see series_acceleration::transform_all
+*/
+template <std::unsigned_integral K, typename transform_type>
+auto transform_all_sums(const K n, const K order, const transform_type& test)
+{
+	using sums_type = decltype(test->transform_all(n, order));
+	try
+	{
+		return test->transform_all(n, order);
+	}
+	catch (std::domain_error&) {}
+	catch (std::overflow_error&) {}
+
+	return sums_type(n + 1, std::numeric_limits<typename sums_type::value_type>::quiet_NaN());
+}
+
+/**
+* @brief Function that takes the transformed partial sum of first i terms from the result of transform_all_sums
+* The undefined sums are computed once more by operator(), so that the error of the transformation is thrown
+* @tparam transform_type is the type of transformation we are using
+* @param i The number of terms
+* @param order The order of the transformation
+* @param test The type of transformation that is being used
+* @param sums The result of transform_all_sums
+* @return The transformed partial sum of first i terms
+*/
+template <std::unsigned_integral K, typename transform_type, std::floating_point T>
+T transformed_sum(const K i, const K order, const transform_type& test, const std::vector<T>& sums)
+{
+	return std::isnan(sums[i]) ? test->operator()(i, order) : sums[i];
+}
+
+/**
+* @brief Function that checks the transformations of all orders computed at once by all_orders against operator()
+* all_orders(n, order)[k] must be equal to operator()(n, k) for every k <= order, or NaN where operator() fails
+* @tparam transform_type is the type of transformation we are using, it must have all_orders
+* @param n The number of terms
+* @param order The largest order of the transformation
+* @param test The type of transformation that is being used
+* @param out The stream the mismatches are printed to
+* @return Whether all orders match
+*/
+template <std::unsigned_integral K, typename transform_type>
+bool check_all_orders(const K n, const K order, const transform_type& test, std::ostream& out = std::cout)
+{
+	const auto all = test->all_orders(n, order);
+	bool matches = true;
+
+	for (K k = 0; k <= order; ++k) {
+		bool defined = true;
+		auto expected = all[k];
+		try
+		{
+			expected = test->operator()(n, k);
+		}
+		catch (std::overflow_error&)
+		{
+			defined = false;
+		}
+
+		if (defined ? !(all[k] == expected) : !std::isnan(all[k])) {
+			out << "all_orders(" << n << ", " << order << ")[" << k << "] = " << all[k] << ", but T_" << n << " of order " << k << " is "
+				<< (defined ? std::to_string(expected) : std::string("undefined")) << '\n';
+			matches = false;
+		}
+	}
+
+	return matches;
+}
 
  /**
  * @brief Function that prints out comparesment between transformed and nontransformed partial sums
@@ -27,14 +108,15 @@ template <std::unsigned_integral K, typename series_templ, typename transform_ty
 void cmp_sum_and_transform(const K n, const K order, const series_templ&& series, const transform_type&& test)
 {
 	test->print_info();
+	const auto sums = transform_all_sums(n, order, test);
 	for (K i = 1; i <= n; ++i) {
 		try 
 		{
 			std::cout << "Sum of algo : " << series->get_sum() << '\n';
 			std::cout << "S_" << i << " : " << series->S_n(i) << '\n';
-			std::cout << "T_" << i << " of order " << order << " : " << test->operator()(i, order) << '\n';
+			std::cout << "T_" << i << " of order " << order << " : " << transformed_sum(i, order, test, sums) << '\n';
 			std::cout << "T_" << i << " of order " << order << " - S_" << i
-				<< " : " << test->operator()(i, order) - series->S_n(i) << '\n';
+				<< " : " << transformed_sum(i, order, test, sums) - series->S_n(i) << '\n';
 		}
 		catch (std::domain_error& e)
 		{
@@ -63,13 +145,14 @@ template <std::unsigned_integral K, typename series_templ, typename transform_ty
 void cmp_a_n_and_transform(const K n, const K order, const series_templ&& series, const transform_type&& test)
 {
 	test->print_info();
+	const auto sums = transform_all_sums(n, order, test);
 	for (K i = 1; i <= n; ++i) {
 		try
 		{
 			std::cout << "a_" << i << " : " << (*series)(i) << '\n';
-			std::cout << "t_" << i << " : " << test->operator()(i, order) - test->operator()(i - 1, order) << '\n';
+			std::cout << "t_" << i << " : " << transformed_sum(i, order, test, sums) - transformed_sum(static_cast<K>(i - 1), order, test, sums) << '\n';
 			std::cout << "t_" << i << " of order " << order << " - a_" << i
-				<< " : " << (test->operator()(i, order) - test->operator()(i - 1, order)) - (*series)(i) << '\n';
+				<< " : " << (transformed_sum(i, order, test, sums) - transformed_sum(static_cast<K>(i - 1), order, test, sums)) - (*series)(i) << '\n';
 		}
 		catch (std::domain_error& e)
 		{
@@ -98,10 +181,11 @@ void transformation_remainders(const K n, const K order, const series_templ&& se
 {
 	std::cout << "Tranformation of order " << order << " remainders from i = 1 to " << n << '\n';
 	test->print_info();
+	const auto sums = transform_all_sums(n, order, test);
 	for (K i = 1; i <= n; ++i) {
 		try
 		{
-			std::cout << "S - T_" << i << " : " << series->get_sum() - test->operator()(i, order) << '\n';
+			std::cout << "S - T_" << i << " : " << series->get_sum() - transformed_sum(i, order, test, sums) << '\n';
 		}
 		catch (std::domain_error& e)
 		{
@@ -134,13 +218,15 @@ void cmp_transformations(const K n, const K order, const series_templ&& series,
 	test_1->print_info();
 	std::cout << "The transformation #2 is ";
 	test_2->print_info();
+	const auto sums_1 = transform_all_sums(n, order, test_1);
+	const auto sums_2 = transform_all_sums(n, order, test_2);
 	auto diff_1 = (*series)(0);
 	auto diff_2 = (*series)(0);
 	for (K i = 1; i <= n; ++i) {
 		try
 		{
-			diff_1 = series->get_sum() - test_1->operator()(i, order);
-			diff_2 = series->get_sum() - test_2->operator()(i, order);
+			diff_1 = series->get_sum() - transformed_sum(i, order, test_1, sums_1);
+			diff_2 = series->get_sum() - transformed_sum(i, order, test_2, sums_2);
 			std::cout << "The transformation #1: S - T_" << i << " : " << diff_1 << '\n';
 			std::cout << "The transformation #2: S - T_" << i << " : " << diff_2 << '\n';
 			if (std::abs(diff_1) < std::abs(diff_2))
@@ -173,19 +259,17 @@ void eval_transform_time(const K n, const K order, const series_templ&& series,
 {
 	const auto start_time = std::chrono::system_clock::now();
 	test->print_info();
-	for (K i = 1; i <= n; ++i) {
-		try
-		{
-			test->operator()(i, order);
-		}
-		catch (std::domain_error& e)
-		{
-			std::cout << e.what() << '\n';
-		}
-		catch (std::overflow_error& e)
-		{
-			std::cout << e.what() << '\n';
-		}
+	try
+	{
+		test->transform_all(n, order);
+	}
+	catch (std::domain_error& e)
+	{
+		std::cout << e.what() << '\n';
+	}
+	catch (std::overflow_error& e)
+	{
+		std::cout << e.what() << '\n';
 	}
 	const auto end_time = std::chrono::system_clock::now();
 	const std::chrono::duration<double, std::milli> diff = end_time - start_time;
@@ -199,12 +283,34 @@ void eval_transform_time(const K n, const K order, const series_templ&& series,
 * @authors Kreynin R.G.
 * @tparam series_templ is the type of series whose convergence we accelerate, transform_type is the type of transformation we are using
 * @param n The number of terms
+* @param out The stream to print to
 */
 template <std::unsigned_integral K, typename series_templ>
-void print_sum(const K n, const series_templ&& series)
+void print_sum(const K n, const series_templ&& series, std::ostream& out = std::cout)
+{
+	out << "Sum of algo :" << series->get_sum() << '\n';
+	out << "S_" << n << " : " << series->S_n(n) << '\n';
+}
+
+/**
+* @brief Function that prints the counts of the work done by a transformation call, see instrumentation.h
+* @param counters The counts
+* @param out The stream to print to
+*/
+inline void print_counters(const transform_counters& counters, std::ostream& out = std::cout)
 {
-	std::cout << "Sum of algo :" << series->get_sum() << '\n';
-	std::cout << "S_" << n << " : " << series->S_n(n) << '\n';
+	out << "terms: " << counters.term_evaluations << ", partial sums: " << counters.partial_sums << ", table cells: " << counters.table_cells
+		<< ", near-zero divisions: " << counters.near_zero_divisions << '\n';
+}
+
+/**
+* @brief Function that prints the heap allocations made by a transformation call, see allocation_profiler.h
+* @param counters The allocations
+* @param out The stream to print to
+*/
+inline void print_allocations(const allocation_counters& counters, std::ostream& out = std::cout)
+{
+	out << "allocations: " << counters.allocations << ", allocated bytes: " << counters.bytes << ", peak bytes: " << counters.peak_bytes << '\n';
 }
 
 /**
@@ -217,21 +323,38 @@ void print_sum(const K n, const series_templ&& series)
 * @param order The order of the transformation
 * @param series The series class object to be accelerated
 * @param test The type of transformation that is being used
+* @param out The stream to print to
 */
 template <std::unsigned_integral K, typename transform_type>
-void print_transform(const K n, const K order, const transform_type&& test)
+void print_transform(const K n, const K order, const transform_type&& test, std::ostream& out = std::cout)
 {
-	test->print_info();
+	test->print_info(out);
+	out << "T_" << n << " of order " << order << " : ";
+	const counters_scope scope;
+	const allocation_scope allocations;
+	allocation_counters call_allocations; // read right after the call, so the printing is not counted
 	try
 	{
-		std::cout << "T_" << n << " of order " << order << " : " << test->operator()(n, order) << '\n';
+		const auto result = [&] {
+			SHANKS_TRACE_SCOPE("transform call", typeid(*test).name());
+			return test->operator()(n, order);
+		}();
+		call_allocations = allocations.counters();
+		out << result << '\n';
 	}
 	catch (std::domain_error& e)
 	{
-		std::cout << e.what() << '\n';
+		call_allocations = allocations.counters();
+		out << e.what() << '\n';
 	}
 	catch (std::overflow_error& e)
 	{
-		std::cout << e.what() << '\n';
+		call_allocations = allocations.counters();
+		out << e.what() << '\n';
 	}
+
+	if constexpr (instrumentation_enabled)
+		print_counters(scope.counters(), out);
+	if constexpr (allocation_profiling_enabled)
+		print_allocations(call_allocations, out);
 }
\ No newline at end of file
@@ -46,6 +46,7 @@ public:
 			current[i] = this->series->operator()(i);
 
 		for (K k = 0; k < 1; ++k) { //   1  iter,  iter - ,    ,     ,   iter > 1    0
+			SHANKS_COUNT_CELLS(m);
 			for (K i = 0; i < m; ++i) {
 				i1 = i + 1;
 				i2 = i + 2;
@@ -54,16 +55,12 @@ public:
 
 				delta_next = (i2 < n) ? current[i2] - current[i1] : T(0);
 
+				SHANKS_COUNT_DIVISION(delta - delta_next);
 				next[i] = current[i1] + (delta * delta_next) / (delta - delta_next);
 			}
 			current = next;
 		}
 
-		for (K i = 0; i < n; i++)
-			std::cout << "[ " << current[i] << " ] ";
-
-		std::cout << "\n";
-
 		const T res = current[m - 1];
 
 		if (!std::isfinite(res))
@@ -0,0 +1,236 @@
+/**
+ * @file thread_pool.h
+ * @brief This file contains the work-stealing thread pool used to run independent transformations in parallel
+ * Every worker has its own queue of task numbers. A worker takes the tasks from the front of its queue and, when
+ * the queue is empty, steals from the back of the queues of the other workers, so the long tasks left at the end
+ * of a queue are taken over by the idle workers. The thread calling parallel_for works as the worker 0.
+ * The environment variable SHANKS_THREADS sets the amount of workers, by default it is the amount of hardware threads.
+ */
+
+#pragma once
+
+#include <algorithm>          // Include the algorithm library for std::max
+#include <condition_variable> // Include the condition_variable library for std::condition_variable
+#include <cstddef>            // Include the cstddef library for std::size_t
+#include <cstdlib>            // Include the cstdlib library for std::getenv and std::strtoul
+#include <deque>              // Include the deque library for the task queues
+#include <exception>          // Include the exception library for std::exception_ptr
+#include <functional>         // Include the functional library for std::function
+#include <memory>             // Include the memory library for std::unique_ptr
+#include <mutex>              // Include the mutex library for std::mutex
+#include <thread>             // Include the thread library for std::thread
+#include <vector>             // Include the vector library
+
+/**
+ * @brief Thread pool running the tasks 0, ..., count - 1 of parallel_for with work stealing
+ */
+class work_stealing_pool
+{
+public:
+	/**
+	* @brief Starts the workers, the calling thread is one of them
+	* @param workers The amount of workers, at least 1
+	*/
+	explicit work_stealing_pool(const std::size_t workers = default_workers());
+
+	work_stealing_pool(const work_stealing_pool&) = delete;
+	work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+	/**
+	* @brief Stops and joins the workers
+	*/
+	~work_stealing_pool();
+
+	/**
+	* @brief Runs task(i) for i = 0, ..., count - 1 on the workers and waits until all of them are done
+	* The tasks may run in any order and concurrently. If some of them throw, the first exception is rethrown
+	* after all tasks are done.
+	* @param count The amount of tasks
+	* @param task The task, called with the number of the task
+	*/
+	void parallel_for(const std::size_t count, const std::function<void(std::size_t)>& task);
+
+	/**
+	* @brief Amount of workers
+	* @return The amount of workers including the calling thread
+	*/
+	[[nodiscard]] std::size_t size() const { return queues.size(); }
+
+	/**
+	* @brief The amount of workers set by SHANKS_THREADS or else the amount of hardware threads
+	* @return The default amount of workers
+	*/
+	[[nodiscard]] static std::size_t default_workers();
+
+private:
+	/**
+	* @brief Queue of the task numbers of a worker
+	*/
+	struct task_queue
+	{
+		std::mutex mutex;
+		std::deque<std::size_t> tasks;
+	};
+
+	/**
+	* @brief Takes a task from the front of the own queue or steals one from the back of another queue
+	* @param worker The number of the worker
+	* @param task The taken task
+	* @return Whether a task was taken
+	*/
+	bool take(const std::size_t worker, std::size_t& task);
+
+	/**
+	* @brief Runs the tasks of the current parallel_for until all queues are empty
+	* @param worker The number of the worker
+	*/
+	void work(const std::size_t worker);
+
+	/**
+	* @brief Body of the threads of the workers 1, 2, ...
+	* @param worker The number of the worker
+	*/
+	void loop(const std::size_t worker);
+
+	std::vector<std::unique_ptr<task_queue>> queues;
+	std::vector<std::thread> threads;
+
+	std::mutex mutex; // guards the fields below
+	std::condition_variable started;
+	std::condition_variable finished;
+	const std::function<void(std::size_t)>* job = nullptr;
+	std::size_t generation = 0; // number of the current parallel_for
+	std::size_t done_workers = 0; // workers which finished the current parallel_for
+	bool stopping = false;
+	std::exception_ptr error;
+};
+
+inline work_stealing_pool::work_stealing_pool(const std::size_t workers)
+{
+	const std::size_t count = std::max<std::size_t>(workers, 1);
+
+	queues.reserve(count);
+	for (std::size_t w = 0; w < count; ++w)
+		queues.emplace_back(std::make_unique<task_queue>());
+
+	threads.reserve(count - 1);
+	for (std::size_t w = 1; w < count; ++w)
+		threads.emplace_back(&work_stealing_pool::loop, this, w);
+}
+
+inline work_stealing_pool::~work_stealing_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	started.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+inline std::size_t work_stealing_pool::default_workers()
+{
+	if (const char* forced = std::getenv("SHANKS_THREADS")) {
+		const unsigned long workers = std::strtoul(forced, nullptr, 10);
+		if (workers > 0)
+			return workers;
+	}
+
+	return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+inline void work_stealing_pool::parallel_for(const std::size_t count, const std::function<void(std::size_t)>& task)
+{
+	const std::size_t workers = size();
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	// every worker starts with a contiguous range of the tasks
+	for (std::size_t w = 0; w < workers; ++w) {
+		std::lock_guard<std::mutex> queue_lock(queues[w]->mutex);
+		for (std::size_t i = count * w / workers; i < count * (w + 1) / workers; ++i)
+			queues[w]->tasks.push_back(i);
+	}
+
+	job = &task;
+	error = nullptr;
+	done_workers = 0;
+	++generation;
+	lock.unlock();
+	started.notify_all();
+
+	work(0);
+
+	// the tasks are not taken once all workers saw the queues empty, so job is not used after this wait
+	lock.lock();
+	finished.wait(lock, [this, workers] { return done_workers == workers - 1; });
+	job = nullptr;
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+inline bool work_stealing_pool::take(const std::size_t worker, std::size_t& task)
+{
+	{
+		task_queue& own = *queues[worker];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			task = own.tasks.front();
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+
+	for (std::size_t k = 1; k < queues.size(); ++k) {
+		task_queue& victim = *queues[(worker + k) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty()) {
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline void work_stealing_pool::work(const std::size_t worker)
+{
+	std::size_t task;
+	while (take(worker, task)) {
+		try {
+			(*job)(task);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+}
+
+inline void work_stealing_pool::loop(const std::size_t worker)
+{
+	std::size_t seen = 0;
+
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			started.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+		}
+
+		work(worker);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++done_workers;
+		}
+		finished.notify_one();
+	}
+}
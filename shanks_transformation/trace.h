@@ -0,0 +1,206 @@
+/**
+ * @file trace.h
+ * @brief This file contains the opt-in spans of the work done by test_all_transforms in the Chrome trace-event format
+ * When SHANKS_TRACE is defined, SHANKS_TRACE_SCOPE records the begin and the duration of the enclosing scope in a buffer
+ * of the calling thread, and trace_recorder::write saves the spans of all threads as a JSON file that can be opened
+ * in Perfetto (https://ui.perfetto.dev) or chrome://tracing, one track per thread. The file is named by the environment
+ * variable SHANKS_TRACE_FILE, by default it is shanks_trace.json. Without SHANKS_TRACE the macro expands to nothing.
+ */
+
+#pragma once
+
+#include <chrono>  // Include the chrono library for std::chrono::steady_clock
+#include <cstddef> // Include the cstddef library for std::size_t
+#include <cstdlib> // Include the cstdlib library for std::getenv
+#include <fstream> // Include the fstream library for std::ofstream
+#include <memory>  // Include the memory library for std::unique_ptr
+#include <mutex>   // Include the mutex library for std::mutex
+#include <ostream> // Include the ostream library for std::ostream
+#include <vector>  // Include the vector library
+
+/**
+ * @brief Whether the spans are recorded
+ */
+#ifdef SHANKS_TRACE
+constexpr bool tracing_enabled = true;
+#else
+constexpr bool tracing_enabled = false;
+#endif
+
+/**
+ * @brief Collects the spans of all threads and writes them as a Chrome trace
+ */
+class trace_recorder
+{
+public:
+	/**
+	* @brief A finished span
+	*/
+	struct span
+	{
+		const char* name;   // a string literal
+		const char* detail; // a string with static storage duration or nullptr
+		double begin_us;    // since the construction of the recorder
+		double duration_us;
+	};
+
+	/**
+	* @brief The recorder of the program
+	* @return The recorder
+	*/
+	static trace_recorder& instance()
+	{
+		static trace_recorder recorder;
+		return recorder;
+	}
+
+	/**
+	* @brief Microseconds since the construction of the recorder
+	* @return The time
+	*/
+	[[nodiscard]] double now_us() const
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	/**
+	* @brief Adds a finished span to the buffer of the calling thread
+	* @param finished The span
+	*/
+	void record(const span& finished)
+	{
+		thread_buffer& buffer = own_buffer();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+		buffer.spans.push_back(finished);
+	}
+
+	/**
+	* @brief Writes the spans recorded so far, every thread is a track numbered in the order of its first span
+	* @param out The stream
+	*/
+	void write(std::ostream& out)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+		bool first = true;
+		for (std::size_t tid = 0; tid < buffers.size(); ++tid) {
+			out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << tid
+				<< ", \"args\": {\"name\": \"thread " << tid << "\"}}";
+			first = false;
+
+			std::lock_guard<std::mutex> buffer_lock(buffers[tid]->mutex);
+			for (const span& s : buffers[tid]->spans) {
+				out << ",\n{\"name\": ";
+				write_string(out, s.name);
+				out << ", \"cat\": \"shanks\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": " << s.begin_us << ", \"dur\": " << s.duration_us;
+				if (s.detail != nullptr) {
+					out << ", \"args\": {\"detail\": ";
+					write_string(out, s.detail);
+					out << '}';
+				}
+				out << '}';
+			}
+		}
+		out << "\n]}\n";
+	}
+
+	/**
+	* @brief Writes the spans recorded so far to the file named by SHANKS_TRACE_FILE or else to shanks_trace.json
+	*/
+	void write()
+	{
+		const char* path = std::getenv("SHANKS_TRACE_FILE");
+		std::ofstream file(path != nullptr && *path != '\0' ? path : "shanks_trace.json");
+		file.precision(15);
+		write(file);
+	}
+
+private:
+	/**
+	* @brief The spans of a thread
+	*/
+	struct thread_buffer
+	{
+		std::mutex mutex; // taken by the thread while adding a span and by write
+		std::vector<span> spans;
+	};
+
+	trace_recorder() : epoch(std::chrono::steady_clock::now()) {}
+
+	/**
+	* @brief The buffer of the calling thread, it is registered on the first call and outlives the thread
+	* @return The buffer
+	*/
+	thread_buffer& own_buffer()
+	{
+		thread_local thread_buffer* buffer = nullptr;
+		if (buffer == nullptr) {
+			std::lock_guard<std::mutex> lock(mutex);
+			buffers.emplace_back(std::make_unique<thread_buffer>());
+			buffer = buffers.back().get();
+		}
+		return *buffer;
+	}
+
+	/**
+	* @brief Writes the string as a JSON string
+	* @param out The stream
+	* @param value The string
+	*/
+	static void write_string(std::ostream& out, const char* value)
+	{
+		out << '"';
+		for (; *value != '\0'; ++value) {
+			if (*value == '"' || *value == '\\')
+				out << '\\' << *value;
+			else if (static_cast<unsigned char>(*value) >= 0x20)
+				out << *value;
+		}
+		out << '"';
+	}
+
+	const std::chrono::steady_clock::time_point epoch;
+	std::mutex mutex; // guards buffers
+	std::vector<std::unique_ptr<thread_buffer>> buffers;
+};
+
+/**
+ * @brief Records the lifetime of the scope as a span of the calling thread
+ */
+class trace_span
+{
+public:
+	/**
+	* @brief Begins the span
+	* @param name The name of the span, a string literal
+	* @param detail The string shown in the arguments of the span, it must outlive the recorder, or nullptr
+	*/
+	explicit trace_span(const char* name, const char* detail = nullptr) : name(name), detail(detail), begin_us(trace_recorder::instance().now_us()) {}
+
+	trace_span(const trace_span&) = delete;
+	trace_span& operator=(const trace_span&) = delete;
+
+	/**
+	* @brief Ends the span
+	*/
+	~trace_span()
+	{
+		trace_recorder& recorder = trace_recorder::instance();
+		recorder.record({ name, detail, begin_us, recorder.now_us() - begin_us });
+	}
+
+private:
+	const char* const name;
+	const char* const detail;
+	const double begin_us;
+};
+
+#define SHANKS_TRACE_CONCAT_IMPL(a, b) a##b
+#define SHANKS_TRACE_CONCAT(a, b) SHANKS_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef SHANKS_TRACE
+#define SHANKS_TRACE_SCOPE(...) const trace_span SHANKS_TRACE_CONCAT(trace_span_, __LINE__)(__VA_ARGS__)
+#else
+#define SHANKS_TRACE_SCOPE(...) ((void)0)
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file triangular_table.h
+ * @brief This file contains the packed triangular table used by the Ford-Sidi algorithms
+ * The Ford-Sidi tables are triangles: the column j holds only the rows last_row - j, ..., last_row.
+ * Storing them as full matrices wastes half of the memory, so the columns are packed one after another
+ * into one vector, and every column is contiguous.
+ */
+
+#pragma once
+
+#include "workspace.h" // Include the per-thread workspace
+#include <concepts> // Include the concepts library for std::floating_point
+#include <cstddef>  // Include the cstddef library for std::size_t
+
+/**
+ * @brief Triangular table of the columns 0, ..., columns - 1, the column j holds the rows last_row - j, ..., last_row
+ * The table is zero-initialized and its storage is taken from the workspace of the calling thread.
+ * @tparam T The type of the elements
+ */
+template <std::floating_point T>
+class triangular_table
+{
+public:
+	/**
+	* @brief Takes a zeroed table from the workspace of the calling thread
+	* @param columns The amount of columns
+	* @param last_row The last row of every column, it must not be less than columns - 1
+	*/
+	triangular_table(const std::size_t columns, const std::size_t last_row) : last_row(last_row), values(columns * (columns + 1) / 2) {}
+
+	/**
+	* @brief Element of the table
+	* @param i The row, last_row - j <= i <= last_row
+	* @param j The column
+	* @return Reference to the element
+	*/
+	[[nodiscard]] T& operator()(const std::size_t i, const std::size_t j) { return values[index(i, j)]; }
+	[[nodiscard]] const T& operator()(const std::size_t i, const std::size_t j) const { return values[index(i, j)]; }
+
+	/**
+	* @brief Amount of the stored elements
+	* @return columns * (columns + 1) / 2
+	*/
+	[[nodiscard]] std::size_t size() const { return values.size(); }
+
+private:
+	/**
+	* @brief Position of the element in the packed storage, the column j starts at j * (j + 1) / 2
+	*/
+	[[nodiscard]] std::size_t index(const std::size_t i, const std::size_t j) const { return j * (j + 1) / 2 + i + j - last_row; }
+
+	const std::size_t last_row;
+	workspace_vector<T> values;
+};
@@ -0,0 +1,76 @@
+/**
+ * @file two_row_tableau.h
+ * @brief This file contains the two-row tableau used by the transformations that keep only two rows of their table
+ * Both rows lie in one buffer taken from the workspace of the calling thread and start at cache line boundaries.
+ * The rows are exchanged by exchanging two pointers, so the loops over a row work on plain arrays.
+ */
+
+#pragma once
+
+#include "workspace.h" // Include the per-thread workspace
+#include <concepts> // Include the concepts library for std::floating_point
+#include <cstddef>  // Include the cstddef library for std::size_t
+#include <memory>   // Include the memory library for std::align
+#include <utility>  // Include the utility library for std::swap
+
+/**
+ * @brief Two zero-initialized rows of the same width stored in one aligned buffer
+ * @tparam T The type of the elements
+ */
+template <std::floating_point T>
+class two_row_tableau
+{
+public:
+	/**
+	* @brief Alignment of the rows in bytes
+	*/
+	static constexpr std::size_t alignment = 64;
+
+	/**
+	* @brief Takes a zeroed buffer for two rows from the workspace of the calling thread
+	* @param width The amount of elements in a row
+	*/
+	explicit two_row_tableau(const std::size_t width);
+
+	two_row_tableau(const two_row_tableau&) = delete;
+	two_row_tableau& operator=(const two_row_tableau&) = delete;
+
+	/**
+	* @brief Row of the tableau
+	* @param r The row, 0 or 1
+	* @return Pointer to the first element of the row
+	*/
+	[[nodiscard]] T* row(const std::size_t r) { return rows[r]; }
+	[[nodiscard]] const T* row(const std::size_t r) const { return rows[r]; }
+
+	/**
+	* @brief Amount of elements in a row
+	* @return The width of the tableau
+	*/
+	[[nodiscard]] std::size_t width() const { return row_width; }
+
+	/**
+	* @brief Exchanges the rows 0 and 1
+	*/
+	void swap_rows() { std::swap(rows[0], rows[1]); }
+
+private:
+	static constexpr std::size_t line = alignment / sizeof(T) == 0 ? 1 : alignment / sizeof(T); // elements in an aligned block
+
+	std::size_t row_width;
+	workspace_vector<T> storage;
+	T* rows[2];
+};
+
+template <std::floating_point T>
+two_row_tableau<T>::two_row_tableau(const std::size_t width) : row_width(width), storage(2 * ((width + line - 1) / line * line) + line)
+{
+	const std::size_t stride = (width + line - 1) / line * line; // the second row starts at an aligned block too
+
+	void* first = storage.data();
+	std::size_t space = storage.size() * sizeof(T);
+	std::align(alignment, 2 * stride * sizeof(T), first, space);
+
+	rows[0] = static_cast<T*>(first);
+	rows[1] = rows[0] + stride;
+}
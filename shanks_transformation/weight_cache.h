@@ -0,0 +1,208 @@
+/**
+ * @file weight_cache.h
+ * @brief This file contains the cache of the weights of the Levin-type transformations
+ * The weights of the Levin, Levin-Sidi S and M and Weniger transformations (binomial coefficients, Pochhammer ratios, powers)
+ * depend only on n, order and the parameter of the transformation, not on the series, so they are computed once
+ * and shared by all transformations and series of the same types T and K. The cache holds at most capacity() bytes
+ * of weights: a sweep over n builds a new table for every n, so the least recently used tables are dropped first.
+ */
+
+#pragma once
+
+#include <cmath>     // Include the cmath library for std::isfinite
+#include <concepts>  // Include the concepts library for std::floating_point
+#include <cstddef>   // Include the cstddef library for std::size_t
+#include <list>      // Include the list library for the order of use
+#include <map>       // Include the map library for the tables
+#include <memory>    // Include the memory library for std::shared_ptr
+#include <mutex>     // Include the mutex library for std::lock_guard
+#include <stdexcept> // Include the stdexcept library for std::domain_error
+#include <tuple>     // Include the tuple library for the key
+#include <vector>    // Include the vector library
+
+/**
+ * @brief Enum of the transformations whose weights are cached
+ */
+enum weight_kind_t {
+	levin_weights,
+	levi_sidi_S_weights,
+	M_levin_sidi_weights,
+	weniger_weights
+};
+
+/**
+ * @brief Cache of weight tables keyed by (kind, n, order, parameter)
+ * A missing table is built without holding the lock, so the builders of different tables run in parallel; if two threads
+ * build the same table, the first one stored is kept. When the stored tables exceed the capacity, the least recently used
+ * ones are dropped; a table larger than the capacity is returned without being stored.
+ * The returned tables are immutable and stay valid after they are dropped.
+ * @tparam T The type of the elements in the series, K The type of enumerating integer
+ */
+template <std::floating_point T, std::unsigned_integral K>
+class weight_cache
+{
+public:
+	using table_type = std::shared_ptr<const std::vector<T>>;
+
+	static constexpr std::size_t default_capacity = std::size_t(64) << 20; // bytes of weights
+
+	weight_cache(const weight_cache&) = delete;
+	weight_cache& operator=(const weight_cache&) = delete;
+
+	/**
+	* @brief The cache shared by all transformations with these T and K
+	* @return Reference to the cache
+	*/
+	static weight_cache& instance();
+
+	/**
+	* @brief Returns the weight table, building it if it is not cached yet
+	* @param kind The transformation the weights belong to
+	* @param n The number of terms in the partial sum
+	* @param order The order of transformation
+	* @param parameter The parameter of the transformation (beta, gamma), 0 if it has none
+	* @param build Functor without arguments returning std::vector<T> of the weights
+	* @return The weight table
+	* @throws std::domain_error if the parameter is not finite
+	*/
+	template <typename Builder>
+	table_type get(const weight_kind_t kind, const K n, const K order, const T parameter, Builder&& build);
+
+	/**
+	* @brief Drops all cached tables, the tables already returned stay valid
+	*/
+	void clear();
+
+	/**
+	* @brief Amount of cached tables
+	* @return The amount of cached tables
+	*/
+	[[nodiscard]] std::size_t size() const;
+
+	/**
+	* @brief The most bytes of weights kept in the cache
+	* @return The capacity in bytes
+	*/
+	[[nodiscard]] std::size_t capacity() const;
+
+	/**
+	* @brief Sets the most bytes of weights kept in the cache and drops the least recently used tables above it
+	* @param bytes The capacity in bytes, 0 disables the caching
+	*/
+	void set_capacity(std::size_t bytes);
+
+private:
+	weight_cache() = default;
+
+	using key_type = std::tuple<weight_kind_t, K, K, T>;
+
+	struct entry
+	{
+		table_type table;
+		typename std::list<key_type>::iterator use; // position in uses
+	};
+
+	/**
+	* @brief Drops the least recently used tables until the stored bytes fit in the capacity, the caller holds the lock
+	*/
+	void evict();
+
+	/**
+	* @brief Bytes of the weights of a table
+	* @param table The table
+	* @return The bytes
+	*/
+	static std::size_t bytes_of(const table_type& table) { return table->size() * sizeof(T); }
+
+	std::map<key_type, entry> tables;
+	std::list<key_type> uses; // the keys of tables, the most recently used first
+	std::size_t stored_bytes = 0;
+	std::size_t max_bytes = default_capacity;
+	mutable std::mutex mutex; // a lookup moves the table in uses, so it is exclusive as well
+};
+
+template <std::floating_point T, std::unsigned_integral K>
+weight_cache<T, K>& weight_cache<T, K>::instance()
+{
+	static weight_cache cache;
+	return cache;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+template <typename Builder>
+typename weight_cache<T, K>::table_type weight_cache<T, K>::get(const weight_kind_t kind, const K n, const K order, const T parameter, Builder&& build)
+{
+	// NaN is not ordered, so it can't be a key of the map
+	if (!std::isfinite(parameter))
+		throw std::domain_error("the parameter of the weights should be finite");
+
+	const key_type key(kind, n, order, parameter);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto found = tables.find(key);
+		if (found != tables.end()) {
+			uses.splice(uses.begin(), uses, found->second.use);
+			return found->second.table;
+		}
+	}
+
+	table_type table = std::make_shared<const std::vector<T>>(build());
+
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto found = tables.find(key);
+	if (found != tables.end()) {
+		uses.splice(uses.begin(), uses, found->second.use);
+		return found->second.table;
+	}
+	if (bytes_of(table) > max_bytes)
+		return table;
+
+	uses.push_front(key);
+	tables.emplace(key, entry{ table, uses.begin() });
+	stored_bytes += bytes_of(table);
+	evict();
+	return table;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+void weight_cache<T, K>::evict()
+{
+	while (stored_bytes > max_bytes) {
+		const auto oldest = tables.find(uses.back());
+		stored_bytes -= bytes_of(oldest->second.table);
+		tables.erase(oldest);
+		uses.pop_back();
+	}
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+void weight_cache<T, K>::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	tables.clear();
+	uses.clear();
+	stored_bytes = 0;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+std::size_t weight_cache<T, K>::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return tables.size();
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+std::size_t weight_cache<T, K>::capacity() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return max_bytes;
+}
+
+template <std::floating_point T, std::unsigned_integral K>
+void weight_cache<T, K>::set_capacity(const std::size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	max_bytes = bytes;
+	evict();
+}
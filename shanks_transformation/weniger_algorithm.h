@@ -7,7 +7,9 @@
 #define DEF_UNDEFINED_SUM 0
 
 #include "series_acceleration.h" // Include the series header
+#include "weight_cache.h" // Include the cache of the weights
 #include <iostream>
+#include <vector>
 
 template<std::floating_point T, std::unsigned_integral K, typename series_templ>
 class weniger_algorithm : public series_acceleration<T, K, series_templ>
@@ -42,37 +44,27 @@ public:
 	* @return The partial sum after the transformation.
 	*/
 
-	T operator()(const K n, const K order) const {
+	T operator()([[maybe_unused]] const K n, const K order) const {
 
-		T numerator = T(0), denominator = T(0);
-		T a_n, rest;
-		T coef = T(1);
+		const auto weights = weight_cache<T, K>::instance().get(weniger_weights, 0, order, T(0), [&]() { return calculate_weights(order); });
 
+		T numerator = T(0), denominator = T(0);
+		T a_n;
 
-		T binomial_coef = this->series->binomial_coefficient(static_cast<T>(n), 0);
 		T S_n = this->series->S_n(0);
 
 		T rest_a_n;
 
-		for (K m = 0; m < order - 1; ++m) 
-			coef *= (1 + m);
-		
 		//TODO   ,    ,    
 		K j1;
 
+		SHANKS_COUNT_CELLS(order + 1);
 		for (K j = 0; j <= order; ++j) {
 			j1 = j + 1;
 
-			rest = this->series->minus_one_raised_to_power_n(j) * binomial_coef;
-			binomial_coef *= (order - j) / j1;
-
-			rest *= coef;
-
-			coef *= (j + order) / j1;
-
 			a_n = 1 / this->series->operator()(j1);
 
-			rest_a_n = rest * a_n;
+			rest_a_n = (*weights)[j] * a_n;
 
 			numerator += rest_a_n * S_n;
 
@@ -81,10 +73,45 @@ public:
 			denominator += rest_a_n;
 
 		}
+		SHANKS_COUNT_DIVISION(denominator);
 		numerator /= denominator;
 		if (!std::isfinite(numerator))
 			throw std::overflow_error("division by zero");
 
 		return numerator;
 	}
+
+private:
+	/**
+	* @brief Function to calculate the weights of the transformation: (-1)^j, the binomial coefficients and the Pochhammer symbols.
+	* They depend only on the order, so operator() takes them from weight_cache.
+	* @param order The order of transformation.
+	* @return Vector of order + 1 weights.
+	*/
+
+	static std::vector<T> calculate_weights(const K order) {
+		std::vector<T> weights(order + 1, 0);
+		T rest;
+		T coef = T(1);
+
+		T binomial_coef = T(1);
+
+		for (K m = 0; m + 1 < order; ++m)
+			coef *= (1 + m);
+
+		K j1;
+
+		for (K j = 0; j <= order; ++j) {
+			j1 = j + 1;
+
+			rest = series_base<T, K>::minus_one_raised_to_power_n(j) * binomial_coef;
+			binomial_coef *= (order - j) / j1;
+
+			weights[j] = rest * coef;
+
+			coef *= (j + order) / j1;
+		}
+
+		return weights;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file workspace.h
+ * @brief This file contains the per-thread workspace the transformations take their scratch vectors from
+ * A transformation call used to allocate its tables on every call. A workspace_vector instead takes a vector
+ * from the pool of the calling thread and gives it back on destruction, so once the pool has grown to the sizes
+ * a transformation needs, the calls do not allocate at all.
+ */
+
+#pragma once
+
+#include <concepts> // Include the concepts library for std::floating_point
+#include <cstddef>  // Include the cstddef library for std::size_t
+#include <utility>  // Include the utility library for std::move
+#include <vector>   // Include the vector library
+
+/**
+ * @brief Scratch vector taken from the workspace of the calling thread
+ * It behaves like a std::vector<T> of fixed size filled with the given value. The pool is a stack, so nested
+ * scratch vectors (e.g. a transformation using another one) are independent, and the same sequence of calls
+ * gets back the same vectors with the capacity they already have.
+ * @tparam T The type of the elements
+ */
+template <std::floating_point T>
+class workspace_vector
+{
+public:
+	/**
+	* @brief Takes a vector from the workspace of the calling thread
+	* @param size The size of the vector
+	* @param value The value to fill the vector with
+	*/
+	explicit workspace_vector(const std::size_t size, const T value = T(0));
+
+	workspace_vector(workspace_vector&& other) noexcept;
+	workspace_vector& operator=(workspace_vector&& other) noexcept;
+
+	workspace_vector(const workspace_vector&) = delete;
+	workspace_vector& operator=(const workspace_vector&) = delete;
+
+	/**
+	* @brief Gives the vector back to the workspace of the calling thread
+	*/
+	~workspace_vector();
+
+	[[nodiscard]] T& operator[](const std::size_t i) { return buffer[i]; }
+	[[nodiscard]] const T& operator[](const std::size_t i) const { return buffer[i]; }
+
+	[[nodiscard]] std::size_t size() const { return buffer.size(); }
+	[[nodiscard]] T* data() { return buffer.data(); }
+	[[nodiscard]] const T* data() const { return buffer.data(); }
+
+	/**
+	* @brief The underlying vector, for the operations workspace_vector does not provide
+	* @return Reference to the underlying vector
+	*/
+	[[nodiscard]] std::vector<T>& get() { return buffer; }
+
+private:
+	/**
+	* @brief The vectors given back by the scratch vectors of the calling thread
+	*/
+	static std::vector<std::vector<T>>& pool();
+
+	std::vector<T> buffer;
+};
+
+template <std::floating_point T>
+std::vector<std::vector<T>>& workspace_vector<T>::pool()
+{
+	thread_local std::vector<std::vector<T>> vectors;
+	return vectors;
+}
+
+template <std::floating_point T>
+workspace_vector<T>::workspace_vector(const std::size_t size, const T value)
+{
+	auto& vectors = pool();
+	if (!vectors.empty()) {
+		buffer = std::move(vectors.back());
+		vectors.pop_back();
+	}
+	buffer.assign(size, value);
+}
+
+template <std::floating_point T>
+workspace_vector<T>::workspace_vector(workspace_vector&& other) noexcept : buffer(std::move(other.buffer)) {}
+
+template <std::floating_point T>
+workspace_vector<T>& workspace_vector<T>::operator=(workspace_vector&& other) noexcept
+{
+	buffer.swap(other.buffer);
+	return *this;
+}
+
+template <std::floating_point T>
+workspace_vector<T>::~workspace_vector()
+{
+	if (buffer.capacity() != 0)
+		try {
+			pool().push_back(std::move(buffer));
+		}
+		catch (...) {} // the vector is simply freed if the pool cannot grow
+}